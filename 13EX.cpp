@@ -5,1217 +5,7200 @@
 #include <memory>
 #include <iomanip>
 #include <cmath>
+#include <fstream>
+#include <sstream>
+#include <functional>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <queue>
+#include <unordered_map>
+#include <filesystem>
+#include <list>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <charconv>
+#include <string_view>
+#include <cstdio>
+#include <ctime>
+#include <deque>
 using namespace std;
 
+/////////////////////////////////////////////////////////
+// Plain window description (what inputDimensions() asks for)
+/////////////////////////////////////////////////////////
+
+// Field meaning depends on the window type; unused fields stay at their
+// defaults. Lets windows be built from files and generators, not just cin.
+struct WindowSpec {
+    int type = 0;
+    int collar = 1;                 // collar type, or subtype for slide corners
+    int netType = 0;                // 3 glass part net type (1 to 4)
+    bool includeTee = false, hasNet = false, includeD46 = false, hasColler = false;
+    float height = 0, width = 0, widthRight = 0;   // widthRight only on corner windows
+    float tee = 0, netWidth = 0, arch = 0;         // netWidth doubles as the D29 width on slide corners
+    int archShape = 0;                             // ArchShape; 0 = arch length typed by hand
+    float rise = 0;                                // arch rise above the springing line
+    string segments;                               // bay windows: role + width per segment, "F36,S48,F36"
+};
+
+// One spec per line: type collar netType tee net d46 coller height width
+// widthRight teeSize netWidth arch archShape rise [segments]. Floats keep 9
+// digits so they round-trip.
+string formatSpec(const WindowSpec& s) {
+    ostringstream out;
+    out << setprecision(9)
+        << s.type << ' ' << s.collar << ' ' << s.netType << ' '
+        << s.includeTee << ' ' << s.hasNet << ' ' << s.includeD46 << ' ' << s.hasColler << ' '
+        << s.height << ' ' << s.width << ' ' << s.widthRight << ' '
+        << s.tee << ' ' << s.netWidth << ' ' << s.arch << ' '
+        << s.archShape << ' ' << s.rise;
+    if (!s.segments.empty()) out << ' ' << s.segments;
+    return out.str();
+}
+
+bool parseSpec(istream& in, WindowSpec& s) {
+    if (!(in >> s.type >> s.collar >> s.netType
+             >> s.includeTee >> s.hasNet >> s.includeD46 >> s.hasColler
+             >> s.height >> s.width >> s.widthRight
+             >> s.tee >> s.netWidth >> s.arch))
+        return false;
+
+    // Arch shape and rise were added later; older lines end before them.
+    int shape;
+    float rise;
+    if (in >> shape >> rise) {
+        s.archShape = shape;
+        s.rise = rise;
+        in >> ws;
+        if (in.peek() == 'F' || in.peek() == 'S') in >> s.segments;  // bay windows only
+    }
+    return true;
+}
+
+/////////////////////////////////////////////////////////
+// 📏 Dimension Units (mm, cm, m, feet-inches -> inches)
+/////////////////////////////////////////////////////////
+
+// Everything past this point works in inches. Site surveys come in other
+// units, so sizes may carry one: 1200mm, 120cm, 1.2m, 48in, 48", 4ft, 4',
+// 5'3", 5'3 1/2", 5ft3-1/2in, 3-1/2. Bare numbers use the caller's default.
+class Units {
+public:
+    enum Unit : uint8_t { Inch, Millimetre, Centimetre, Metre, Foot, kUnitCount };
+
+    static constexpr float kToInches[kUnitCount] = { 1.0f, 1 / 25.4f, 1 / 2.54f, 1 / 0.0254f, 12.0f };
+
+    static const char* name(Unit u) {
+        static const char* names[kUnitCount] = { "in", "mm", "cm", "m", "ft" };
+        return names[u];
+    }
+
+    static bool unitFromName(string_view text, Unit& u) {
+        text = trim(text);
+        if (text.empty() || text == "\"" || same(text, "in") || same(text, "inch") || same(text, "inches")) u = Inch;
+        else if (same(text, "mm"))                                       u = Millimetre;
+        else if (same(text, "cm"))                                       u = Centimetre;
+        else if (same(text, "m"))                                        u = Metre;
+        else if (text == "'" || same(text, "ft") || same(text, "feet") || same(text, "foot")) u = Foot;
+        else return false;
+        return true;
+    }
+
+    // Splits text into a number and its unit without scaling it, so a whole
+    // column can be scaled in one pass by toInches(). Feet-inches and
+    // fractions come back already in inches.
+    static bool split(string_view text, float& value, Unit& unit, Unit fallback = Inch) {
+        text = trim(text);
+        float whole;
+        if (!mixedNumber(text, whole)) return false;
+
+        string_view rest = trim(text);
+        size_t feetMark = rest.empty() ? 0 : rest[0] == '\'' ? 1 : prefix(rest, "ft") ? 2 : 0;
+        if (feetMark) {
+            rest = trim(rest.substr(feetMark));
+            if (!rest.empty() && rest[0] == '-') rest = trim(rest.substr(1));
+            float inches = 0;
+            if (!rest.empty()) {
+                if (!mixedNumber(rest, inches)) return false;
+                Unit tail;
+                if (!unitFromName(rest, tail) || tail != Inch) return false;
+            }
+            value = whole * 12 + inches;
+            unit = Inch;
+            return true;
+        }
+
+        if (rest.empty()) unit = fallback;
+        else if (!unitFromName(rest, unit)) return false;
+        value = whole;
+        return true;
+    }
+
+    static bool parse(string_view text, float& inches, Unit fallback = Inch) {
+        float value;
+        Unit unit;
+        if (!split(text, value, unit, fallback)) return false;
+        inches = value * kToInches[unit];
+        return true;
+    }
+
+    // One table lookup and multiply per value, no branches, so the compiler
+    // vectorises it; survey imports scale each size column with one call.
+    static void toInches(const float* values, const Unit* units, float* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) out[i] = values[i] * kToInches[units[i]];
+    }
+
+private:
+    static string_view trim(string_view s) {
+        while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+        while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+        return s;
+    }
+
+    static bool same(string_view a, const char* b) {
+        size_t n = strlen(b);
+        if (a.size() != n) return false;
+        for (size_t i = 0; i < n; ++i)
+            if (tolower(static_cast<unsigned char>(a[i])) != b[i]) return false;
+        return true;
+    }
+
+    static bool prefix(string_view s, const char* p) { return s.size() >= strlen(p) && same(s.substr(0, strlen(p)), p); }
+
+    static bool number(string_view& s, float& v) {
+        if (s.empty() || !(isdigit(static_cast<unsigned char>(s[0])) || s[0] == '.')) return false;
+        auto result = from_chars(s.data(), s.data() + s.size(), v);
+        if (result.ec != errc() || !isfinite(v)) return false;
+        s.remove_prefix(result.ptr - s.data());
+        return true;
+    }
+
+    // 3, 3.5, 1/2, 3 1/2 or 3-1/2; consumes what it reads from s.
+    static bool mixedNumber(string_view& s, float& v) {
+        if (!number(s, v)) return false;
+        if (!s.empty() && s[0] == '/') return fraction(v, s, v);
+
+        if (!s.empty() && (s[0] == ' ' || s[0] == '-')) {
+            string_view after = s.substr(1);
+            while (!after.empty() && after[0] == ' ') after.remove_prefix(1);
+            float top;
+            if (number(after, top) && !after.empty() && after[0] == '/') {
+                float part;
+                if (!fraction(top, after, part)) return false;
+                v += part;
+                s = after;
+            }
+        }
+        return true;
+    }
+
+    static bool fraction(float top, string_view& s, float& v) {
+        s.remove_prefix(1);  // '/'
+        float bottom;
+        if (!number(s, bottom) || bottom == 0) return false;
+        v = top / bottom;
+        return true;
+    }
+};
+
+// cin >> asInches(height) takes the same units as survey files, with or
+// without a space before the unit (1200 mm, 4 ft 6 in, 5' 3 1/2"). A bad
+// answer is reported, the rest of its line dropped and the value left as
+// it was; the stream fails, like cin >> int does, so prompt loops ask again
+// even where 0 is a valid answer (see rejected()).
+// cin >> asSize(height, "h") also checks the size range of the window type
+// being entered (see InchesField::Limits), like a project file import.
+struct WindowTypeInfo;
+
+struct InchesField {
+    float& value;
+    const char* key = nullptr;  // h, w, wr...; nullptr = no range check
+
+    // Size range for asSize() fields while this is in scope.
+    struct Limits {
+        explicit Limits(const WindowTypeInfo* info) : saved(active) { active = info; }
+        ~Limits() { active = saved; }
+        const WindowTypeInfo* saved;
+    };
+    static inline const WindowTypeInfo* active = nullptr;
+};
+
+inline InchesField asInches(float& value) { return { value }; }
+inline InchesField asSize(float& value, const char* key) { return { value, key }; }
+
+istream& operator>>(istream& in, InchesField field);  // after WindowTypeInfo
+
+// True when the last answer was rejected; clears the stream for the next try:
+//     do { cout << "Rise: "; cin >> asInches(rise); } while (rejected(cin) || rise < 0);
+inline bool rejected(istream& in) {
+    if (!in.fail()) return false;
+    in.clear();
+    return true;
+}
+
+// Prompt suffix for every size question.
+const char* const kSizeUnits = "(inches, or e.g. 4'6\", 1200mm, 120cm)";
+
+/////////////////////////////////////////////////////////
+// Shop-floor operations a window needs (for scheduling)
+/////////////////////////////////////////////////////////
+
+enum class Station { Saw = 0, Bench = 1, Glazing = 2 };
+const int kStationCount = 3;
+
+// Minutes per unit of work; overridable from shop.cfg.
+struct FabTimes {
+    float cutSetup = 2.0f, perCut = 1.5f;
+    float perJoint = 4.0f, teeFix = 10.0f, netFit = 15.0f, sash = 12.0f;
+    float glassBase = 5.0f, glassPerSqFt = 1.5f;
+};
+
+struct FabOperation {
+    string name;
+    Station station;
+    float minutes;
+};
+
+// One mesh panel as it sits inside its D29 frame, in inches.
+struct NetPanel {
+    float height, width;
+};
+
+// One piece for the saw, in inches. label says where it goes: "H", "W",
+// "W+9" (width plus collar allowance), "T" (tee)...
+struct CutPiece {
+    string profile;
+    float length;
+    string label;
+};
+
+// One line of a window's hardware kit. Part names are string literals, so
+// kits can be expanded by the million without allocating.
+struct HardwareLine {
+    const char* part;
+    float qty;  // pieces, or feet for parts named "(ft)"
+};
+
+/////////////////////////////////////////////////////////
+// 🖨️ Report Output (per-thread buffer, written in large blocks)
+/////////////////////////////////////////////////////////
+
+// Itemised quotes are formatted with to_chars into a reusable buffer per
+// thread and written with one fwrite per block: no stream state or locale
+// per number, no allocation once the buffer has grown. A render call ends
+// with done(), which writes straight away unless a Report::Batch is open;
+// a batch writes once at the end (or every 64 KB). Blocks from different
+// threads never interleave inside a line.
+class Report {
+    static constexpr size_t kFlushAt = 64 * 1024;
+
+    string buf;
+    FILE* sink = stdout;
+    int batchDepth = 0;
+
+    static mutex& writeLock() {
+        static mutex m;
+        return m;
+    }
+
+public:
+    static Report& out() {
+        thread_local Report perThread;
+        return perThread;
+    }
+
+    ~Report() { flush(); }
+
+    // Pending text goes to the old sink first.
+    void redirect(FILE* to) {
+        flush();
+        sink = to;
+    }
+
+    Report& operator<<(string_view text) {
+        buf.append(text.data(), text.size());
+        return *this;
+    }
+
+    Report& operator<<(char c) {
+        buf.push_back(c);
+        return *this;
+    }
+
+    Report& operator<<(long long v) {
+        char digits[24];
+        auto end = to_chars(digits, digits + sizeof digits, v).ptr;
+        buf.append(digits, end);
+        return *this;
+    }
+
+    Report& operator<<(int v) { return *this << static_cast<long long>(v); }
+    Report& operator<<(size_t v) { return *this << static_cast<long long>(v); }
+
+    // Same digits as fixed << setprecision(decimals).
+    Report& fixed(float v, int decimals = 2) {
+        char digits[64];
+        auto result = to_chars(digits, digits + sizeof digits, v, chars_format::fixed, decimals);
+        if (result.ec == errc()) buf.append(digits, result.ptr);
+        else buf += "?";
+        return *this;
+    }
+
+    Report& operator<<(float v) { return fixed(v); }
+
+    void flush() {
+        if (buf.empty()) return;
+        cout.flush();  // keeps order with anything still going through cout
+        lock_guard<mutex> guard(writeLock());
+        if (sink) {  // nullptr discards
+            fwrite(buf.data(), 1, buf.size(), sink);
+            fflush(sink);
+        }
+        buf.clear();
+    }
+
+    void done() {
+        if (batchDepth == 0 || buf.size() >= kFlushAt) flush();
+    }
+
+    // Holds done() back for a whole batch of windows.
+    struct Batch {
+        Batch() { ++out().batchDepth; }
+        ~Batch() {
+            Report& r = out();
+            if (--r.batchDepth == 0) r.flush();
+        }
+    };
+};
+
+/////////////////////////////////////////////////////////
+// 🧾 Session Journal (record a session, replay it later)
+/////////////////////////////////////////////////////////
+
+// --record FILE keeps an append-only binary journal of a session:
+//   "WFJ1", then records of [type byte][varint length][payload]
+//   H  build stamp, start time
+//   I  one line of cin input, exactly as consumed
+//   R  section rate used for pricing and where it came from
+//   F  contents of an input file (offcuts, cost rates, imports...)
+//   Q  a result: running totals after each menu action, net totals
+// Every record is flushed as it is written, so a crash loses nothing.
+//
+// --replay FILE [RATES.csv] runs the same session with no prompts: input
+// and files come from the journal, rates too unless RATES.csv overrides
+// them, and the results are diffed against the recorded ones. Nothing is
+// written to disk while replaying.
+class SessionJournal {
+public:
+    static SessionJournal& get() {
+        static SessionJournal journal;
+        return journal;
+    }
+
+    bool recording() const { return out != nullptr; }
+    bool replaying() const { return replayMode; }
+
+    bool startRecording(const string& path) {
+        out = fopen(path.c_str(), "wb");
+        if (!out) {
+            cerr << "❌ Error: Could not write journal " << path << "\n";
+            return false;
+        }
+        fwrite("WFJ1", 1, 4, out);
+        string header;
+        putString(header, buildStamp());
+        putVarint(header, static_cast<uint64_t>(time(nullptr)));
+        put('H', header);
+
+        tee.src = cin.rdbuf();
+        cin.rdbuf(&tee);
+        return true;
+    }
+
+    bool startReplay(const string& path, const string& ratesCsv) {
+        ifstream in(path, ios::binary);
+        string data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        if (!in.is_open() || data.compare(0, 4, "WFJ1") != 0) {
+            cerr << "❌ Error: " << path << " is not a session journal\n";
+            return false;
+        }
+
+        string input;
+        size_t at = 4;
+        while (at < data.size()) {
+            char type = data[at++];
+            uint64_t length;
+            if (!getVarint(data, at, length) || at + length > data.size()) {
+                cerr << "⚠️ Journal ends in a partial record; replaying what was complete.\n";
+                break;
+            }
+            string_view payload(data.data() + at, length);
+            at += length;
+
+            size_t p = 0;
+            if (type == 'I') {
+                input.append(payload);
+            } else if (type == 'H') {
+                recordedBuild = getString(payload, p);
+                uint64_t started = 0;
+                getVarint(payload, p, started);
+                recordedAt = static_cast<time_t>(started);
+            } else if (type == 'R') {
+                RateRecord r;
+                string section = getString(payload, p);
+                r.source = getString(payload, p);
+                if (p + sizeof r.rate <= payload.size()) memcpy(&r.rate, payload.data() + p, sizeof r.rate);
+                p += sizeof r.rate;
+                // Older journals have no batch number; a batch's sections
+                // come in sorted order, so a repeat or step back starts the next.
+                uint64_t batch;
+                if (p < payload.size() && getVarint(payload, p, batch)) inferredBatch = batch;
+                else if (lastSection.empty() || section <= lastSection) ++inferredBatch;
+                lastSection = section;
+                rates[{ inferredBatch, section }] = move(r);
+            } else if (type == 'F') {
+                string file = getString(payload, p);
+                bool exists = p < payload.size() && payload[p++] == 1;
+                files[file].push_back({ exists, string(payload.substr(min(p, payload.size()))) });
+            } else if (type == 'Q') {
+                string label = getString(payload, p);
+                double value = 0;
+                if (p + sizeof value <= payload.size()) memcpy(&value, payload.data() + p, sizeof value);
+                recorded.emplace_back(move(label), value);
+            }
+        }
+
+        if (!ratesCsv.empty() && !loadOverrides(ratesCsv)) return false;
+
+        journalPath = path;
+        inputBytes = input.size();
+        replayMode = true;
+        replayInput.reset(input);
+        cin.rdbuf(&replayInput);
+        savedCout = cout.rdbuf(&discard);  // no prompts
+        Report::out().redirect(nullptr);
+        return true;
+    }
+
+    // Each collectRates() call is one batch; rates are recorded and
+    // replayed by (batch, section), so a batch that needs a section more
+    // or fewer does not shift the rates of the ones after it.
+    void beginRateBatch() { ++rateBatch; }
+
+    // A rate the pricing code settled on. source is the supplier, or
+    // "typed" when it was entered at the prompt.
+    void recordRate(const string& section, float rate, const string& source) {
+        if (!recording()) return;
+        string payload;
+        putString(payload, section);
+        putString(payload, source);
+        payload.append(reinterpret_cast<const char*>(&rate), sizeof rate);
+        putVarint(payload, rateBatch);
+        put('R', payload);
+    }
+
+    // While replaying: the rate recorded for this section in this batch,
+    // or the override for it. A typed rate is read off the replayed input
+    // as well, even when overridden, so the rest of the input stays in step.
+    bool replayRate(const string& section, float& rate) {
+        if (!replaying()) return false;
+        auto r = rates.find({ rateBatch, section });
+        if (r != rates.end()) {
+            rate = r->second.rate;
+            if (r->second.source == "typed") {
+                float typed;
+                while (!(cin >> typed) || typed < 0) {
+                    cin.clear(); cin.ignore(10000, '\n');
+                }
+            }
+        } else {
+            rate = 0;
+            notes.push_back("no recorded rate for " + section + " in batch " + to_string(rateBatch) + ", priced at 0");
+        }
+
+        auto o = overrides.find(section);
+        if (o != overrides.end()) {
+            if (o->second != rate) ++overridden;
+            rate = o->second;
+        }
+        return true;
+    }
+
+    // Whole file contents, from disk or, while replaying, from the journal.
+    // Returns false when the file did not exist.
+    bool readFile(const string& path, string& text) {
+        if (replaying()) {
+            auto it = files.find(path);
+            if (it != files.end() && !it->second.empty()) {
+                pair<bool, string> snapshot = move(it->second.front());
+                it->second.pop_front();
+                text = move(snapshot.second);
+                return snapshot.first;
+            }
+            notes.push_back(path + " was not in the journal, read from disk");
+        }
+
+        ifstream in(path, ios::binary);
+        text.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        bool exists = in.is_open();
+        if (recording()) {
+            string payload;
+            putString(payload, path);
+            payload += static_cast<char>(exists ? 1 : 0);
+            payload += text;
+            put('F', payload);
+        }
+        return exists;
+    }
+
+    void result(const string& label, double value) {
+        if (recording()) {
+            string payload;
+            putString(payload, label);
+            payload.append(reinterpret_cast<const char*>(&value), sizeof value);
+            put('Q', payload);
+        } else if (replaying()) {
+            replayed.emplace_back(label, value);
+        }
+    }
+
+    // Totals after every menu action.
+    void checkpoint(double aluminium, double sqft, size_t windows) {
+        if (!recording() && !replaying()) return;
+        string step = "step " + to_string(++steps) + " ";
+        result(step + "aluminium", aluminium);
+        result(step + "sqft", sqft);
+        result(step + "windows", static_cast<double>(windows));
+    }
+
+    void close() {
+        if (!out) return;
+        flushInput();
+        fclose(out);
+        out = nullptr;
+        cin.rdbuf(tee.src);
+    }
+
+    // Prints the diff and ends the program: 0 when every result matches.
+    [[noreturn]] void finishReplay(bool truncated) {
+        cout.rdbuf(savedCout);
+        Report::out().redirect(stdout);
+
+        cout << fixed << setprecision(2);
+        cout << "\n=== Replay of " << journalPath << " ===\n";
+        char when[32] = "?";
+        if (recordedAt) strftime(when, sizeof when, "%Y-%m-%d %H:%M", localtime(&recordedAt));
+        cout << "Recorded " << when << " by build " << recordedBuild << "; replayed by build " << buildStamp() << "\n";
+        cout << inputBytes << " input bytes, " << rates.size() << " recorded rate(s)";
+        if (!overrides.empty()) cout << ", " << overridden << " changed by the rate file";
+        cout << "\n";
+        if (truncated) cout << "⚠️ Input ran out mid-prompt: the session was cut off while recording.\n";
+        for (const string& note : notes) cout << "ℹ️ " << note << "\n";
+
+        size_t differ = 0, count = max(recorded.size(), replayed.size());
+        for (size_t i = 0; i < count; ++i) {
+            bool haveOld = i < recorded.size(), haveNew = i < replayed.size();
+            double before = haveOld ? recorded[i].second : 0, after = haveNew ? replayed[i].second : 0;
+            bool sameLabel = haveOld && haveNew && recorded[i].first == replayed[i].first;
+            if (sameLabel && fabs(before - after) <= 0.005) continue;
+            if (++differ > 40) continue;
+            const string& label = haveOld ? recorded[i].first : replayed[i].first;
+            cout << "  " << left << setw(34) << label << right;
+            if (!haveOld) cout << "(not recorded) => " << after << "\n";
+            else if (!haveNew) cout << before << " => (not reached)\n";
+            else if (!sameLabel) cout << "replay went a different way here (" << replayed[i].first << ")\n";
+            else cout << setw(14) << before << " => " << setw(14) << after << "  (" << showpos << after - before
+                      << noshowpos << ")\n";
+        }
+        if (differ > 40) cout << "  ... and " << differ - 40 << " more\n";
+
+        if (differ == 0) cout << "✅ All " << count << " results match the recording.\n";
+        else cout << "⚠️ " << differ << " of " << count << " results differ from the recording.\n";
+        cout.flush();
+        exit(differ == 0 && !truncated ? 0 : 1);
+    }
+
+private:
+    struct RateRecord {
+        string source;
+        float rate = 0;
+    };
+
+    // Passes cin through one character at a time, so exactly the consumed
+    // input is journaled (peeked characters are not).
+    struct TeeBuf : streambuf {
+        streambuf* src = nullptr;
+        int_type underflow() override { return src->sgetc(); }
+        int_type uflow() override {
+            int_type c = src->sbumpc();
+            if (c != traits_type::eof()) get().consumed(traits_type::to_char_type(c));
+            return c;
+        }
+        int_type pbackfail(int_type c) override {
+            int_type back = src->sungetc();
+            if (back != traits_type::eof() && !get().pending.empty()) get().pending.pop_back();
+            return back == traits_type::eof() ? back : c;
+        }
+        streamsize showmanyc() override { return src->in_avail(); }
+    };
+
+    // Recorded input. Prompts that keep retrying at end of input would spin
+    // forever, so running dry repeatedly ends the replay.
+    struct ReplayBuf : streambuf {
+        string data;
+        int dryReads = 0;
+        void reset(const string& input) {
+            data = input;
+            setg(&data[0], &data[0], &data[0] + data.size());
+        }
+        int_type underflow() override {
+            if (++dryReads > 1000) get().finishReplay(true);
+            return traits_type::eof();
+        }
+    };
+
+    struct DiscardBuf : streambuf {
+        int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+        streamsize xsputn(const char*, streamsize n) override { return n; }
+    };
+
+    FILE* out = nullptr;
+    string pending;  // input line being recorded
+    TeeBuf tee;
+
+    bool replayMode = false;
+    ReplayBuf replayInput;
+    DiscardBuf discard;
+    streambuf* savedCout = nullptr;
+    string journalPath, recordedBuild;
+    time_t recordedAt = 0;
+    size_t inputBytes = 0, overridden = 0;
+    uint64_t rateBatch = 0, inferredBatch = 0;
+    string lastSection;  // while reading older journals
+    int steps = 0;
+    map<pair<uint64_t, string>, RateRecord> rates;  // (batch, section)
+    map<string, deque<pair<bool, string>>> files;
+    vector<pair<string, double>> recorded, replayed;
+    map<string, float> overrides;
+    vector<string> notes;
+
+    static string buildStamp() { return string(__DATE__) + " " + __TIME__; }
+
+    void consumed(char c) {
+        pending += c;
+        if (c == '\n') flushInput();
+    }
+
+    void flushInput() {
+        if (pending.empty() || !out) return;
+        put('I', pending);
+        pending.clear();
+    }
+
+    void put(char type, const string& payload) {
+        if (type != 'I') flushInput();  // keep input and events in order
+        string head(1, type);
+        putVarint(head, payload.size());
+        fwrite(head.data(), 1, head.size(), out);
+        fwrite(payload.data(), 1, payload.size(), out);
+        fflush(out);
+    }
+
+    bool loadOverrides(const string& path) {
+        ifstream in(path);
+        if (!in) {
+            cerr << "❌ Error: Could not read " << path << "\n";
+            return false;
+        }
+        string line;
+        while (getline(in, line)) {
+            size_t comma = line.find(',');
+            if (line.empty() || line[0] == '#' || comma == string::npos) continue;
+            char* end = nullptr;
+            string value = line.substr(comma + 1);
+            float rate = strtof(value.c_str(), &end);
+            if (end != value.c_str()) overrides[line.substr(0, comma)] = rate;
+        }
+        return true;
+    }
+
+    static void putVarint(string& s, uint64_t v) {
+        while (v >= 0x80) {
+            s += static_cast<char>((v & 0x7F) | 0x80);
+            v >>= 7;
+        }
+        s += static_cast<char>(v);
+    }
+
+    static bool getVarint(string_view s, size_t& at, uint64_t& v) {
+        v = 0;
+        for (int shift = 0; at < s.size() && shift < 64; shift += 7) {
+            uint8_t byte = static_cast<uint8_t>(s[at++]);
+            v |= uint64_t(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    static void putString(string& s, const string& text) {
+        putVarint(s, text.size());
+        s += text;
+    }
+
+    static string getString(string_view s, size_t& at) {
+        uint64_t length = 0;
+        if (!getVarint(s, at, length) || at + length > s.size()) {
+            at = s.size();
+            return "";
+        }
+        string text(s.substr(at, length));
+        at += length;
+        return text;
+    }
+};
+
+/////////////////////////////////////////////////////////
+// ♻️ Per-Thread Window Pool
+/////////////////////////////////////////////////////////
+
+// Imports, fuzzing and benchmarks build and drop windows by the thousand.
+// Freed blocks go back on the freeing thread's list for their size class,
+// so every window type reuses blocks of its own size without any locking.
+class ComponentPool {
+    static constexpr size_t kGranule = 16, kClasses = 32;  // blocks up to 512 bytes
+    static constexpr size_t kMaxKept = 4096;               // per class and thread
+
+    struct Lists {
+        vector<void*> free[kClasses];
+        ~Lists() {
+            for (auto& list : free)
+                for (void* p : list) ::operator delete(p);
+        }
+    };
+
+    static Lists& lists() {
+        thread_local Lists perThread;
+        return perThread;
+    }
+
+    static size_t sizeClass(size_t size) { return (size + kGranule - 1) / kGranule; }
+
+public:
+    static void* allocate(size_t size) {
+        size_t c = sizeClass(size);
+        if (c == 0 || c > kClasses) return ::operator new(size);
+
+        vector<void*>& list = lists().free[c - 1];
+        if (list.empty()) return ::operator new(c * kGranule);
+        void* p = list.back();
+        list.pop_back();
+        return p;
+    }
+
+    static void release(void* p, size_t size) {
+        size_t c = sizeClass(size);
+        if (c == 0 || c > kClasses) { ::operator delete(p); return; }
+
+        vector<void*>& list = lists().free[c - 1];
+        if (list.size() >= kMaxKept) { ::operator delete(p); return; }
+        list.push_back(p);
+    }
+};
+
+/////////////////////////////////////////////////////////
+// 🔢 Section Codes (dense IDs shared by every rate table)
+/////////////////////////////////////////////////////////
+
+// Every section code gets a small ID the first time it is seen; IDs never
+// change, so price lists, batch rates and windows can all index arrays by
+// them instead of hashing names. Codes are compared as packed 64-bit keys
+// (first 7 characters + length), so lookups take no lock and allocate
+// nothing; new codes are added under a mutex.
+class SectionCodes {
+public:
+    static constexpr int kCapacity = 1024;
+
+    static int id(const string& code) {
+        Table& t = table();
+        uint64_t key = pack(code);
+        int seen = t.count.load(memory_order_acquire);
+        int found = scan(t, key, code, 0, seen);
+        if (found >= 0) return found;
+
+        lock_guard<mutex> guard(t.grow);
+        int now = t.count.load(memory_order_relaxed);
+        found = scan(t, key, code, seen, now);
+        if (found >= 0) return found;
+        if (now == kCapacity) return -1;
+        t.keys[now] = key;
+        t.names[now] = code;
+        t.count.store(now + 1, memory_order_release);
+        return now;
+    }
+
+    // -1 when the code has never been seen.
+    static int find(const string& code) {
+        Table& t = table();
+        return scan(t, pack(code), code, 0, t.count.load(memory_order_acquire));
+    }
+
+    static const string& name(int id) { return table().names[id]; }
+    static int count() { return table().count.load(memory_order_acquire); }
+
+    // A code that got no ID (table full) keeps its name here instead, so
+    // references to it stay valid like those from name().
+    static const string& overflowName(const string& code) {
+        Table& t = table();
+        lock_guard<mutex> guard(t.grow);
+        return *t.overflow.insert(code).first;
+    }
+
+private:
+    struct Table {
+        uint64_t keys[kCapacity];
+        string names[kCapacity];
+        atomic<int> count{0};
+        mutex grow;
+        set<string> overflow;  // codes past kCapacity; nodes never move
+    };
+
+    static Table& table() {
+        static Table t;
+        return t;
+    }
+
+    static uint64_t pack(const string& code) {
+        uint64_t key = 0;
+        for (size_t i = 0; i < 7; ++i) key = key << 8 | (i < code.size() ? static_cast<uint8_t>(code[i]) : 0);
+        return key << 8 | min<size_t>(code.size(), 255);
+    }
+
+    static int scan(const Table& t, uint64_t key, const string& code, int from, int to) {
+        for (int i = from; i < to; ++i)
+            if (t.keys[i] == key && (code.size() <= 7 || t.names[i] == code)) return i;
+        return -1;
+    }
+};
+
+// One batch's rates, resolved once: by code for itemised printouts and the
+// quote cache, by section ID for pricing.
+class RateTable {
+    map<string, float> byCode;
+    vector<float> byId;  // SectionCodes ID -> rate, NaN = no rate entered
+
+public:
+    RateTable() = default;
+
+    explicit RateTable(map<string, float> rates) : byCode(move(rates)) {
+        for (const auto& r : byCode) {
+            int id = SectionCodes::id(r.first);
+            if (id < 0) continue;
+            if (id >= static_cast<int>(byId.size())) byId.resize(id + 1, NAN);
+            byId[id] = r.second;
+        }
+    }
+
+    const map<string, float>& byName() const { return byCode; }
+
+    float rate(int id) const {
+        return (id >= 0 && id < static_cast<int>(byId.size())) ? byId[id] : NAN;
+    }
+};
+
+// A window's sections in code order, as getRequiredSections() returns them,
+// stored flat: about 16 bytes per section instead of a map node and a
+// string. Entries read like the map's pairs (first = code, second =
+// inches) and also carry the SectionCodes ID.
+class SectionList {
+public:
+    struct Entry {
+        const string& first;  // owned by SectionCodes (name or overflowName), never moves
+        float second;
+        int16_t id;
+    };
+
+    void assign(const map<string, float>& sections) {
+        entries.clear();
+        entries.reserve(sections.size());
+        for (const auto& s : sections) {
+            int id = SectionCodes::id(s.first);
+            const string& code = id >= 0 ? SectionCodes::name(id) : SectionCodes::overflowName(s.first);
+            entries.push_back({ code, s.second, static_cast<int16_t>(id) });
+        }
+        entries.shrink_to_fit();
+    }
+
+    vector<Entry>::const_iterator begin() const { return entries.begin(); }
+    vector<Entry>::const_iterator end() const { return entries.end(); }
+    size_t size() const { return entries.size(); }
+
+    vector<Entry>::const_iterator find(const string& code) const {
+        int id = SectionCodes::find(code);
+        for (auto it = entries.begin(); it != entries.end(); ++it)
+            if (id >= 0 ? it->id == id : it->first == code) return it;
+        return entries.end();
+    }
+    size_t count(const string& code) const { return find(code) != end(); }
+    float at(const string& code) const {
+        auto it = find(code);
+        if (it == end()) throw out_of_range("section " + code);
+        return it->second;
+    }
+
+private:
+    vector<Entry> entries;
+};
+
 /////////////////////////////////////////////////////////
 // Abstract Base Class for All Frame Components
 /////////////////////////////////////////////////////////
 
-class FrameComponent {
-public:
-    virtual void inputDimensions() = 0;
-    virtual void displayType() const = 0;
-    virtual map<string, float> getRequiredSections() const = 0;
-    virtual float calculateTotalPrice(const map<string, float>& rates) const = 0;
-    virtual float getArea() const = 0;
-    virtual ~FrameComponent() = default;
+class FrameComponent {
+public:
+    virtual void inputDimensions() = 0;
+    virtual void loadSpec(const WindowSpec& spec) = 0;  // same as inputDimensions, no prompts
+    virtual WindowSpec getSpec() const = 0;             // type is left for the caller
+    virtual void displayType() const = 0;
+    virtual map<string, float> getRequiredSections() const = 0;
+    virtual float calculateTotalPrice(const map<string, float>& rates) const = 0;
+    virtual float getArea() const = 0;
+    virtual float roundToMarketFeet(float inches) const = 0;  // each type keeps its own market rule
+    virtual int cornerJoints() const { return 4; }
+    // Whether growing spec.height / spec.width changes the sections at all;
+    // the sensitivity analysis shows n/a where it does not.
+    virtual bool drivesHeight() const { return true; }
+    virtual bool drivesWidth() const { return true; }
+    virtual vector<NetPanel> getNetPanels() const { return {}; }  // one per D29 frame
+
+    // The individual pieces behind getRequiredSections(): per profile they
+    // add up to the same inches. Types without a breakdown cut each
+    // section as one length.
+    virtual void getCutPieces(vector<CutPiece>& out) const {
+        for (const auto& s : requiredSections()) out.push_back({ s.first, s.second, "L" });
+    }
+
+    // Parts every glazed frame needs; types append their own on top.
+    virtual void getHardware(vector<HardwareLine>& kit) const {
+        WindowSpec spec = getSpec();
+        if (cornerJoints() > 0) kit.push_back({ "Frame screw", 4.0f * cornerJoints() });
+        float perimeter = 2 * (spec.height + spec.width + spec.widthRight);
+        if (perimeter > 0) kit.push_back({ "Glazing gasket (ft)", perimeter / 12 });
+    }
+    virtual ~FrameComponent() = default;
+
+    // Sized delete gets the derived size through the virtual destructor.
+    static void* operator new(size_t size) { return ComponentPool::allocate(size); }
+    static void operator delete(void* p, size_t size) { ComponentPool::release(p, size); }
+
+    // Work needed on the shop floor, in order: cuts (saw), frame assembly
+    // (bench), glazing. Derived from the sections the window needs.
+    virtual vector<FabOperation> getOperations(const FabTimes& t) const {
+        vector<FabOperation> ops;
+        const SectionList& sections = requiredSections();
+        WindowSpec spec = getSpec();
+        float side = (spec.height + spec.width) / 2;
+
+        for (const auto& s : sections) {
+            // Aggregate length split into pieces of about one side each.
+            long pieces = side > 0 ? max(1L, lround(s.second / side)) : 1;
+            ops.push_back({ "Cut " + s.first, Station::Saw, t.cutSetup + t.perCut * pieces });
+        }
+
+        if (cornerJoints() > 0)
+            ops.push_back({ "Corner joints", Station::Bench, t.perJoint * cornerJoints() });
+        if (sections.count("D52") || sections.count("D40"))
+            ops.push_back({ "Tee fixing", Station::Bench, t.teeFix });
+        if (sections.count("M28") && spec.height > 0)
+            ops.push_back({ "Sash assembly", Station::Bench, t.sash * lround(sections.at("M28") / spec.height) });
+        if (sections.count("D29"))
+            ops.push_back({ "Net fitting", Station::Bench, t.netFit });
+
+        float area = getArea();
+        if (area > 0)
+            ops.push_back({ "Glass fitting", Station::Glazing, t.glassBase + t.glassPerSqFt * area });
+
+        return ops;
+    }
+
+    // getRequiredSections() computed once per set of dimensions and shared by
+    // pricing, summaries and reports. inputDimensions() and loadSpec()
+    // invalidate it.
+    //
+    // Thread safety: any number of threads may call this (and everything
+    // built on it) on the same window at once; the first one fills the memo
+    // under a striped lock and the rest wait for it. Changing the dimensions
+    // is a write and must not overlap readers of that window.
+    const SectionList& requiredSections() const {
+        if (!sectionsValid.load(memory_order_acquire)) {
+            lock_guard<mutex> guard(memoLock(this));
+            if (!sectionsValid.load(memory_order_relaxed)) {
+                cachedSections.assign(getRequiredSections());
+                sectionsValid.store(true, memory_order_release);
+                sectionComputations.fetch_add(1, memory_order_relaxed);
+            }
+        }
+        return cachedSections;
+    }
+
+    // Aluminium cost against a batch's rates: one indexed load per section.
+    // Sections without a rate are left out, as in calculateTotalPrice().
+    float aluminiumCost(const RateTable& rates) const {
+        float total = 0;
+        for (const auto& sec : requiredSections()) {
+            float rate = rates.rate(sec.id);
+            if (!isnan(rate)) total += roundToMarketFeet(sec.second) * rate;
+        }
+        return total;
+    }
+
+    // Section memos filled so far; take the difference around a batch.
+    static long long sectionComputationCount() { return sectionComputations.load(memory_order_relaxed); }
+
+    // Same price as one line of calculateTotalPrice, without the printout.
+    // Returns false when no rate was entered for the section.
+    bool sectionCost(const string& code, float inches, const map<string, float>& rates, float& cost) const {
+        auto rate = rates.find(code);
+        if (rate == rates.end()) return false;
+        cost = roundToMarketFeet(inches) * rate->second;
+        return true;
+    }
+
+    // Same, by section ID (SectionList::Entry::id).
+    bool sectionCost(int id, float inches, const RateTable& rates, float& cost) const {
+        float rate = rates.rate(id);
+        if (isnan(rate)) return false;
+        cost = roundToMarketFeet(inches) * rate;
+        return true;
+    }
+
+    // One itemised line of calculateTotalPrice().
+    static void printSectionLine(const string& code, float inches, float roundedFeet, float price,
+                                 bool cached = false) {
+        Report& out = Report::out();
+        out << code << ": " << inches << " inches = " << inches / 12.0f << " ft => rounded = "
+            << roundedFeet << " => Rs. " << price << (cached ? " (cached)\n" : "\n");
+    }
+
+protected:
+    void invalidateSections() { sectionsValid.store(false, memory_order_release); }
+
+    static void cut(vector<CutPiece>& out, const string& profile, int count, float length, const string& label) {
+        for (int i = 0; i < count; ++i) out.push_back({ profile, length, label });
+    }
+
+    // Every calculateTotalPrice handles a missing rate the same way:
+    // warn and leave the section out of the total.
+    static bool findRate(const map<string, float>& rates, const string& code, float& rate) {
+        auto it = rates.find(code);
+        if (it == rates.end()) {
+            Report::out() << "⚠️ Rate missing for section: " << code << "\n";
+            return false;
+        }
+        rate = it->second;
+        return true;
+    }
+
+private:
+    mutable SectionList cachedSections;
+    mutable atomic<bool> sectionsValid{false};
+    static inline atomic<long long> sectionComputations{0};
+
+    // 64 locks shared by all windows, so a window carries no mutex of its own.
+    static mutex& memoLock(const void* window) {
+        static mutex locks[64];
+        return locks[(reinterpret_cast<uintptr_t>(window) >> 4) % 64];
+    }
+};
+/////////////////////////////////////////////////////////
+// 📏 Collar Rule Library (one formula table per profile family)
+/////////////////////////////////////////////////////////
+
+// One section of a collar rule:
+//     length = height * perHeight + width * perWidth + allowance
+struct CollarTerm {
+    unsigned char slot;  // which of the family's section names
+    unsigned char perHeight, perWidth, allowance;
+};
+
+struct CollarRule {
+    unsigned char count;
+    CollarTerm terms[3];
+};
+
+template <size_t N>
+struct CollarTable {
+    unsigned char slots;    // section names the family uses
+    CollarRule rules[N];    // rules[collar - 1]
+};
+
+struct CollarRules {
+    // Sliding frames (FlexiblePanelWindow, ThreePanel_3glass): 30 and 26
+    // series, C = collar profile, F = frame profile.
+    enum { C30, F30, C26, F26 };
+    static constexpr CollarTable<14> sliding = { 4, {
+        /*  1 */ { 2, { { F30, 2, 1, 9 }, { F26, 0, 1, 3 } } },
+        /*  2 */ { 2, { { C30, 2, 1, 0 }, { C26, 0, 1, 0 } } },
+        /*  3 */ { 3, { { C30, 0, 1, 0 }, { F30, 2, 0, 6 }, { F26, 0, 1, 3 } } },
+        /*  4 */ { 3, { { C30, 1, 0, 0 }, { F30, 1, 1, 6 }, { F26, 0, 1, 3 } } },
+        /*  5 */ { 2, { { F30, 2, 1, 9 }, { C26, 0, 1, 0 } } },
+        /*  6 */ { 3, { { C30, 1, 0, 0 }, { F30, 1, 1, 6 }, { F26, 0, 1, 3 } } },
+        /*  7 */ { 3, { { C30, 1, 1, 0 }, { F30, 1, 0, 3 }, { F26, 0, 1, 3 } } },
+        /*  8 */ { 3, { { C30, 1, 0, 0 }, { F30, 1, 1, 6 }, { C26, 0, 1, 0 } } },
+        /*  9 */ { 3, { { C30, 2, 0, 0 }, { F30, 0, 1, 3 }, { F26, 0, 1, 3 } } },
+        /* 10 */ { 3, { { C30, 0, 1, 0 }, { F30, 2, 0, 6 }, { C26, 0, 1, 0 } } },
+        /* 11 */ { 3, { { C30, 2, 0, 0 }, { F30, 0, 1, 3 }, { C26, 0, 1, 0 } } },
+        /* 12 */ { 3, { { C30, 1, 1, 0 }, { F30, 1, 0, 3 }, { C26, 0, 1, 0 } } },
+        /* 13 */ { 2, { { C30, 2, 1, 0 }, { F26, 0, 1, 3 } } },
+        /* 14 */ { 3, { { C30, 1, 1, 0 }, { F30, 1, 0, 3 }, { F26, 0, 1, 0 } } },
+    } };
+
+    // Single-profile frames: F = with collar (D54F / D50F), A = plain
+    // (D54A / D50A). FixWindow and OpenableWindow share the 14-type table;
+    // doors and the qadial arch have their own 8-type variants.
+    enum { F, A };
+    static constexpr CollarTable<14> fixed = { 2, {
+        /*  1 */ { 1, { { F, 2, 2, 12 } } },
+        /*  2 */ { 1, { { A, 2, 2, 0 } } },
+        /*  3 */ { 2, { { F, 2, 1, 9 }, { A, 0, 1, 0 } } },
+        /*  4 */ { 2, { { F, 1, 2, 9 }, { A, 1, 0, 0 } } },
+        /*  5 */ { 2, { { F, 2, 1, 9 }, { A, 0, 1, 0 } } },
+        /*  6 */ { 2, { { F, 1, 2, 9 }, { A, 1, 0, 0 } } },
+        /*  7 */ { 2, { { F, 1, 1, 6 }, { A, 1, 1, 0 } } },
+        /*  8 */ { 2, { { F, 1, 1, 6 }, { A, 1, 1, 0 } } },
+        /*  9 */ { 2, { { F, 2, 0, 6 }, { A, 0, 2, 0 } } },
+        /* 10 */ { 2, { { F, 0, 2, 6 }, { A, 2, 0, 0 } } },
+        /* 11 */ { 2, { { F, 0, 1, 3 }, { A, 2, 1, 0 } } },
+        /* 12 */ { 2, { { F, 3, 0, 0 }, { A, 1, 2, 0 } } },
+        /* 13 */ { 2, { { F, 0, 1, 3 }, { A, 2, 1, 0 } } },
+        /* 14 */ { 2, { { F, 1, 0, 3 }, { A, 1, 2, 0 } } },
+    } };
+
+    static constexpr CollarTable<8> door = { 2, {
+        /* 1 */ { 1, { { F, 2, 1, 9 } } },
+        /* 2 */ { 1, { { A, 2, 1, 0 } } },
+        /* 3 */ { 2, { { F, 1, 1, 6 }, { A, 1, 0, 0 } } },
+        /* 4 */ { 2, { { F, 2, 0, 6 }, { A, 0, 1, 0 } } },
+        /* 5 */ { 2, { { F, 1, 1, 6 }, { A, 1, 0, 0 } } },
+        /* 6 */ { 2, { { F, 1, 0, 3 }, { A, 1, 1, 0 } } },
+        /* 7 */ { 2, { { F, 1, 0, 3 }, { A, 1, 1, 0 } } },
+        /* 8 */ { 2, { { F, 0, 1, 3 }, { A, 2, 0, 0 } } },
+    } };
+
+    static constexpr CollarTable<8> qadial = { 2, {
+        /* 1 */ { 2, { { F, 2, 1, 9 }, { A, 0, 1, 0 } } },
+        /* 2 */ { 1, { { A, 2, 2, 0 } } },
+        /* 3 */ { 2, { { F, 1, 1, 6 }, { A, 1, 1, 0 } } },
+        /* 4 */ { 2, { { F, 2, 0, 6 }, { A, 0, 2, 0 } } },
+        /* 5 */ { 2, { { F, 1, 1, 6 }, { A, 0, 1, 0 } } },
+        /* 6 */ { 2, { { F, 0, 1, 3 }, { A, 3, 1, 0 } } },
+        /* 7 */ { 2, { { F, 1, 0, 3 }, { A, 1, 2, 0 } } },
+        /* 8 */ { 2, { { F, 1, 0, 3 }, { A, 1, 2, 0 } } },
+    } };
+
+    // Every rule has 1-3 terms on distinct, existing slots, and the frame
+    // covers both the height and the width at least once.
+    template <size_t N>
+    static constexpr bool valid(const CollarTable<N>& table) {
+        for (size_t r = 0; r < N; ++r) {
+            const CollarRule& rule = table.rules[r];
+            if (rule.count < 1 || rule.count > 3) return false;
+
+            int perHeight = 0, perWidth = 0;
+            for (int i = 0; i < rule.count; ++i) {
+                if (rule.terms[i].slot >= table.slots) return false;
+                for (int j = 0; j < i; ++j)
+                    if (rule.terms[j].slot == rule.terms[i].slot) return false;
+                perHeight += rule.terms[i].perHeight;
+                perWidth += rule.terms[i].perWidth;
+            }
+            if (perHeight == 0 || perWidth == 0) return false;
+        }
+        return true;
+    }
+
+    // Direct index on the collar type instead of a switch per class.
+    // Unknown collar types add nothing, like the old default branches.
+    template <size_t N>
+    static void apply(const CollarTable<N>& table, int collar, float h, float w,
+                      const string* names, map<string, float>& sections) {
+        if (collar < 1 || collar > static_cast<int>(N)) return;
+
+        const CollarRule& rule = table.rules[collar - 1];
+        for (int i = 0; i < rule.count; ++i) {
+            const CollarTerm& t = rule.terms[i];
+            sections[names[t.slot]] = (h * t.perHeight + w * t.perWidth) + t.allowance;
+        }
+    }
+
+    // Same rule as pieces: perHeight cuts of h, perWidth cuts of w, and the
+    // allowance on the last cut of the profile.
+    template <size_t N>
+    static void cuts(const CollarTable<N>& table, int collar, float h, float w,
+                     const string* names, vector<CutPiece>& out) {
+        if (collar < 1 || collar > static_cast<int>(N)) return;
+
+        const CollarRule& rule = table.rules[collar - 1];
+        for (int i = 0; i < rule.count; ++i) {
+            const CollarTerm& t = rule.terms[i];
+            for (int k = 0; k < t.perHeight; ++k) out.push_back({ names[t.slot], h, "H" });
+            for (int k = 0; k < t.perWidth; ++k) out.push_back({ names[t.slot], w, "W" });
+            if (t.allowance) {
+                out.back().length += t.allowance;
+                out.back().label += "+" + to_string(t.allowance);
+            }
+        }
+    }
+};
+
+static_assert(CollarRules::valid(CollarRules::sliding), "sliding collar table is inconsistent");
+static_assert(CollarRules::valid(CollarRules::fixed), "fixed collar table is inconsistent");
+static_assert(CollarRules::valid(CollarRules::door), "door collar table is inconsistent");
+static_assert(CollarRules::valid(CollarRules::qadial), "qadial collar table is inconsistent");
+
+/////////////////////////////////////////////////////////
+// 🪟 Three and Two (M section ) Panel Window Class (Type 1 and 2)
+/////////////////////////////////////////////////////////
+
+class FlexiblePanelWindow : public FrameComponent {
+    float height = 0, width = 0;
+    int collerType = 1;
+    bool includeD29 = true;
+    bool useMSeriesSections = false;
+
+public:
+    // Constructor lets you control behavior for any type
+    FlexiblePanelWindow(bool includeD29 = true, bool useMSeries = false)
+        : includeD29(includeD29), useMSeriesSections(useMSeries) {}
+
+    void inputDimensions() override {
+        cout << "Enter Collar Type (1 to 14): ";
+        while (!(cin >> collerType) || collerType < 1 || collerType > 14) {
+            cin.clear(); cin.ignore(1000, '\n');
+            cout << "❌ Invalid input. Please enter collar type (1 to 14): ";
+        }
+
+        cout << "Enter height " << kSizeUnits << ": ";
+        while (!(cin >> asSize(height, "h")) || height <= 0) {
+            cin.clear(); cin.ignore(1000, '\n');
+            cout << "❌ Invalid input. Enter height again " << kSizeUnits << ": ";
+        }
+
+        cout << "Enter width " << kSizeUnits << ": ";
+        while (!(cin >> asSize(width, "w")) || width <= 0) {
+            cin.clear(); cin.ignore(1000, '\n');
+            cout << "❌ Invalid input. Enter width again " << kSizeUnits << ": ";
+        }
+        invalidateSections();
+    }
+
+    void loadSpec(const WindowSpec& spec) override {
+        collerType = spec.collar;
+        height = spec.height;
+        width = spec.width;
+        invalidateSections();
+    }
+
+    WindowSpec getSpec() const override {
+        WindowSpec spec;
+        spec.collar = collerType;
+        spec.height = height;
+        spec.width = width;
+        return spec;
+    }
+
+    void displayType() const override {
+        Report& out = Report::out();
+        out << (includeD29 ? "Three Panel Window\n" : "Two Panel Window\n");
+        out.done();
+    }
+
+    float getArea() const override {
+        return (height / 12.0f) * (width / 12.0f);
+    }
+
+    map<string, float> getRequiredSections() const override {
+        map<string, float> sections;
+        float h = height, w = width;
+
+        // M series swaps the DC profiles for their M equivalents
+        static const string dcNames[] = { "DC30C", "DC30F", "DC26C", "DC26F" };
+        static const string mNames[] = { "M30", "M30F", "M26", "M26F" };
+
+        // Collar logic
+        CollarRules::apply(CollarRules::sliding, collerType, h, w,
+                           useMSeriesSections ? mNames : dcNames, sections);
+
+        // Common members
+        sections["M23"] = h * 2;
+        sections["M28"] = h * 2;
+        sections["M24"] = w * 2;
+
+        if (includeD29)
+            sections["D29"] = (h * 2) + w;
+
+        return sections;
+    }
+
+    // D29 = 2h + w: one net sash, half the window wide.
+    vector<NetPanel> getNetPanels() const override {
+        if (!includeD29) return {};
+        return { { height, width / 2 } };
+    }
+
+    // Two glass sashes, plus the net sash on three panel windows.
+    void getHardware(vector<HardwareLine>& kit) const override {
+        FrameComponent::getHardware(kit);
+        float sashes = includeD29 ? 3 : 2;
+        kit.push_back({ "Sliding roller", 2 * sashes });
+        kit.push_back({ "Crescent lock", 1 });
+        kit.push_back({ "Weather brush (ft)", 2 * height * sashes / 12 });
+    }
+
+    void getCutPieces(vector<CutPiece>& out) const override {
+        static const string dcNames[] = { "DC30C", "DC30F", "DC26C", "DC26F" };
+        static const string mNames[] = { "M30", "M30F", "M26", "M26F" };
+        CollarRules::cuts(CollarRules::sliding, collerType, height, width,
+                          useMSeriesSections ? mNames : dcNames, out);
+
+        cut(out, "M23", 2, height, "H");
+        cut(out, "M28", 2, height, "H");
+        cut(out, "M24", 2, width, "W");
+        if (includeD29) {  // net sash, half the width
+            cut(out, "D29", 2, height, "H");
+            cut(out, "D29", 2, width / 2, "W/2");
+        }
+    }
+
+    float calculateTotalPrice(const map<string, float>& rates) const override {
+        const auto& sections = requiredSections();
+        float total = 0;
+
+        for (const auto& s : sections) {
+            float inches = s.second;
+            float rounded = roundToMarketFeet(inches);
+
+            float rate;
+            if (!findRate(rates, s.first, rate)) continue;
+            float price = rounded * rate;
+            total += price;
+
+            printSectionLine(s.first, inches, rounded, price);
+        }
+
+        Report::out().done();
+        return total;
+    }
+
+  float roundToMarketFeet(float inches) const override {
+    float ft = inches / 12.0f;
+    int fullFeet = static_cast<int>(ft);
+
+    // If inches divide perfectly → use as-is
+    if (fmod(inches, 12.0f) == 0.0f)
+        return fullFeet;
+
+    // Otherwise round up to next full foot
+    return fullFeet + 1.0f;
+}
+};
+
+/////////////////////////////////////////////////////////
+// 🪟 Three and Two Panel Window Class and 3 glass part (Type 1 and 2 in M section)
+/////////////////////////////////////////////////////////
+
+class ThreePanel_3glass : public FrameComponent {
+    float height = 0, width = 0, netwidth = 0;
+    int collerType = 1, net = 2;
+    bool includeD29 = true; // 👈 You can toggle this based on window type
+    string prefix30 = "DC30", prefix26 = "DC26"; // 👈 Flexible prefix system
+
+public:
+    ThreePanel_3glass(bool useD29 = true, string p30 = "DC30", string p26 = "DC26")
+        : includeD29(useD29), prefix30(p30), prefix26(p26) {}
+
+    void inputDimensions() override {
+    if (includeD29) {
+        cout << "Net Types:\n";
+        cout << "1 - Single net (auto width)\n";
+        cout << "2 - Double net (auto width)\n";
+        cout << "3 - Custom single net\n";
+        cout << "4 - Custom double net\n";
+        cin >> net;
+
+        if (net == 3 || net == 4) {
+            do {
+                cout << "Enter the width size of net " << kSizeUnits << ": ";
+                cin >> asInches(netwidth);
+            } while (rejected(cin) || netwidth <= 0);
+        }
+    }
+
+    do {
+        cout << "Enter Coller Type (1 to 14): ";
+        cin >> collerType;
+    } while (collerType < 1 || collerType > 14);
+
+    do {
+        cout << "Enter height " << kSizeUnits << ": ";
+        cin >> asSize(height, "h");
+    } while (rejected(cin) || height <= 0);
+
+    do {
+        cout << "Enter width " << kSizeUnits << ": ";
+        cin >> asSize(width, "w");
+    } while (rejected(cin) || width <= 0);
+    invalidateSections();
+}
+
+    void loadSpec(const WindowSpec& spec) override {
+        net = spec.netType;
+        netwidth = spec.netWidth;
+        collerType = spec.collar;
+        height = spec.height;
+        width = spec.width;
+        invalidateSections();
+    }
+
+    WindowSpec getSpec() const override {
+        WindowSpec spec;
+        spec.netType = net;
+        spec.netWidth = netwidth;
+        spec.collar = collerType;
+        spec.height = height;
+        spec.width = width;
+        return spec;
+    }
+
+    void displayType() const override {
+        Report& out = Report::out();
+        out << "Three Panel and 3 Glass Part Window\n";
+        out.done();
+    }
+
+    float getArea() const override {
+        return (height / 12.0f) * (width / 12.0f);
+    }
+
+    map<string, float> getRequiredSections() const override {
+        map<string, float> sections;
+        float h = height, w = width, n = netwidth;
+
+        const string names[] = { prefix30 + "C", prefix30 + "F", prefix26 + "C", prefix26 + "F" };
+        CollarRules::apply(CollarRules::sliding, collerType, h, w, names, sections);
+
+        // Common sections
+        sections["M23"] = h * 2;
+        sections["M28"] = h * 4;
+        sections["M24"] = w * 2;
+
+        // Optional D29 section
+        if (includeD29) {
+            switch (net) {
+                case 1: sections["D29"] = (h + (w / 3)) * 2; break;
+                case 2: sections["D29"] = (h * 4) + w;       break;
+                case 3: sections["D29"] = (h * 2) + (n * 2); break;
+                case 4: sections["D29"] = (h * 4) + (n * 4); break;
+            }
+        }
+
+        return sections;
+    }
+
+    // Panels whose frames add up to the D29 lengths above.
+    vector<NetPanel> getNetPanels() const override {
+        if (!includeD29) return {};
+        switch (net) {
+            case 1: return { { height, width / 3 } };
+            case 2: return { { height, width / 4 }, { height, width / 4 } };
+            case 3: return { { height, netwidth } };
+            case 4: return { { height, netwidth }, { height, netwidth } };
+        }
+        return {};
+    }
+
+    void getHardware(vector<HardwareLine>& kit) const override {
+        FrameComponent::getHardware(kit);
+        float sashes = 2 + static_cast<float>(getNetPanels().size());
+        kit.push_back({ "Sliding roller", 2 * sashes });
+        kit.push_back({ "Crescent lock", 1 });
+        kit.push_back({ "Weather brush (ft)", 2 * height * sashes / 12 });
+    }
+
+    void getCutPieces(vector<CutPiece>& out) const override {
+        const string names[] = { prefix30 + "C", prefix30 + "F", prefix26 + "C", prefix26 + "F" };
+        CollarRules::cuts(CollarRules::sliding, collerType, height, width, names, out);
+
+        cut(out, "M23", 2, height, "H");
+        cut(out, "M28", 4, height, "H");
+        cut(out, "M24", 2, width, "W");
+        if (!includeD29) return;
+        switch (net) {
+            case 1: cut(out, "D29", 2, height, "H"); cut(out, "D29", 2, width / 3, "W/3"); break;
+            case 2: cut(out, "D29", 4, height, "H"); cut(out, "D29", 4, width / 4, "W/4"); break;
+            case 3: cut(out, "D29", 2, height, "H"); cut(out, "D29", 2, netwidth, "N");   break;
+            case 4: cut(out, "D29", 4, height, "H"); cut(out, "D29", 4, netwidth, "N");   break;
+        }
+    }
+
+    float calculateTotalPrice(const map<string, float>& rates) const override {
+        const auto& sections = requiredSections();
+        float total = 0;
+
+        for (const auto& s : sections) {
+            float inches = s.second;
+            float roundedFeet = roundToMarketFeet(inches);
+
+            float rate;
+            if (!findRate(rates, s.first, rate)) continue;
+            float price = roundedFeet * rate;
+            total += price;
+
+            printSectionLine(s.first, inches, roundedFeet, price);
+        }
+
+        Report::out().done();
+        return total;
+    }
+
+    float roundToMarketFeet(float inches) const override {
+        float ft = inches / 12.0f;
+        int whole = static_cast<int>(floor(ft));
+        float inch = (ft - whole) * 12;
+
+        if (inch <= 6.0f)
+            return whole + 0.6f;
+        else
+            return whole + 1.0f;
+    }
+};
+
+/////////////////////////////////////////////////////////
+// 🪟 Fix Window With or Without Tee
+/////////////////////////////////////////////////////////
+
+class FixWindow : public FrameComponent {
+    float height = 0, width = 0, tee = 0;
+    int collerType = 1;
+    bool includeTee = false;
+
+public:
+    void inputDimensions() override {
+        char tOption;
+        cout << "Include Tee? (y/n): ";
+        cin >> tOption;
+        includeTee = (tOption == 'y' || tOption == 'Y');
+
+        do {
+            cout << "Enter Coller Type (1 to 14): ";
+            cin >> collerType;
+        } while (collerType < 1 || collerType > 14);
+
+        do {
+            cout << "Enter height " << kSizeUnits << ": ";
+            cin >> asSize(height, "h");
+        } while (rejected(cin) || height <= 0);
+
+        do {
+            cout << "Enter width " << kSizeUnits << ": ";
+            cin >> asSize(width, "w");
+        } while (rejected(cin) || width <= 0);
+
+        if (includeTee) {
+            do {
+                cout << "Enter Tee size " << kSizeUnits << ": ";
+                cin >> asInches(tee);
+            } while (rejected(cin) || tee <= 0);
+        }
+        invalidateSections();
+    }
+
+    void loadSpec(const WindowSpec& spec) override {
+        includeTee = spec.includeTee;
+        collerType = spec.collar;
+        height = spec.height;
+        width = spec.width;
+        tee = spec.tee;
+        invalidateSections();
+    }
+
+    WindowSpec getSpec() const override {
+        WindowSpec spec;
+        spec.includeTee = includeTee;
+        spec.collar = collerType;
+        spec.height = height;
+        spec.width = width;
+        spec.tee = tee;
+        return spec;
+    }
+
+    void displayType() const override {
+        Report& out = Report::out();
+        out << "Fixed Window";
+        if (includeTee) out << " with Tee";
+        out << "\n";
+        out.done();
+    }
+
+    float getArea() const override {
+        return (height / 12.0f) * (width / 12.0f);
+    }
+
+    map<string, float> getRequiredSections() const override {
+        map<string, float> sections;
+        float h = height, w = width, t = tee;
+
+        // Apply formulas based on coller type
+        static const string names[] = { "D54F", "D54A" };
+        CollarRules::apply(CollarRules::fixed, collerType, h, w, names, sections);
+
+        if (includeTee) {
+            sections["D52"] = t;
+            sections["D41"] = ((h + w) * 2) + (t * 2);
+        } else {
+            sections["D41"] = (h + w) * 2;
+        }
+
+        return sections;
+    }
+
+    void getHardware(vector<HardwareLine>& kit) const override {
+        FrameComponent::getHardware(kit);
+        if (includeTee) kit.push_back({ "Tee connector", 2 });
+    }
+
+    void getCutPieces(vector<CutPiece>& out) const override {
+        static const string names[] = { "D54F", "D54A" };
+        CollarRules::cuts(CollarRules::fixed, collerType, height, width, names, out);
+
+        cut(out, "D41", 2, height, "H");
+        cut(out, "D41", 2, width, "W");
+        if (includeTee) {
+            cut(out, "D52", 1, tee, "T");
+            cut(out, "D41", 2, tee, "T");
+        }
+    }
+
+    float calculateTotalPrice(const map<string, float>& rates) const override {
+        const auto& sections = requiredSections();
+        float total = 0;
+
+        for (const auto& s : sections) {
+            float inches = s.second;
+            float roundedFeet = roundToMarketFeet(inches);
+
+            float rate;
+            if (!findRate(rates, s.first, rate)) continue;
+            float price = roundedFeet * rate;
+
+            total += price;
+            printSectionLine(s.first, inches, roundedFeet, price);
+        }
+
+        Report::out().done();
+        return total;
+    }
+
+    float roundToMarketFeet(float inches) const override {
+        float ft = inches / 12.0f;
+        int whole = static_cast<int>(floor(ft));
+        float inch = (ft - whole) * 12;
+        return (inch <= 6.0f) ? (whole + 0.6f) : (whole + 1.0f);
+    }
+};
+
+/////////////////////////////////////////////////////////
+// 🪟 Random design Fix Window With or Without Tee
+/////////////////////////////////////////////////////////
+
+class RandomFixWindow : public FrameComponent {
+    float length = 0, tee = 0;
+    bool includeTee = false;
+
+public:
+    void inputDimensions() override {
+        char tOption;
+        cout << "Include Tee? (y/n): ";
+        cin >> tOption;
+        includeTee = (tOption == 'y' || tOption == 'Y');
+
+        do {
+            cout << "Enter total length " << kSizeUnits << ": ";
+            cin >> asSize(length, "length");
+            if (cin && length <= 0) cout << "❌ Length must be greater than 0.\n";
+        } while (rejected(cin) || length <= 0);
+
+        if (includeTee) {
+            do {
+                cout << "Enter Tee size " << kSizeUnits << ": ";
+                cin >> asInches(tee);
+                if (cin && tee <= 0) cout << "❌ Tee size must be greater than 0.\n";
+            } while (rejected(cin) || tee <= 0);
+        }
+        invalidateSections();
+    }
+
+    void loadSpec(const WindowSpec& spec) override {
+        includeTee = spec.includeTee;
+        length = spec.width;
+        tee = spec.tee;
+        invalidateSections();
+    }
+
+    WindowSpec getSpec() const override {
+        WindowSpec spec;
+        spec.includeTee = includeTee;
+        spec.width = length;  // total length travels as width
+        spec.tee = tee;
+        return spec;
+    }
+
+    void displayType() const override {
+        Report& out = Report::out();
+        out << "Random Design Fixed Window";
+        if (includeTee) out << " (with Tee)";
+        out << "\n";
+        out.done();
+    }
+
+    float getArea() const override {
+        return 0.0f;  // Area doesn't apply for random fixed windows
+    }
+
+    int cornerJoints() const override {
+        return 0;  // free-form outline, joints are part of the cut work
+    }
+
+    map<string, float> getRequiredSections() const override {
+        map<string, float> sections;
+        float l = length, t = tee;
+
+        sections["D54"] = l;
+        if (includeTee) {
+            sections["D52"] = t;
+            sections["D41"] = l + (t * 2);
+        } else {
+            sections["D41"] = l;
+        }
+
+        return sections;
+    }
+
+    // A single length: no corners, fixed every foot.
+    void getHardware(vector<HardwareLine>& kit) const override {
+        kit.push_back({ "Frame screw", ceil(length / 12) });
+        kit.push_back({ "Glazing gasket (ft)", 2 * length / 12 });
+        if (includeTee) kit.push_back({ "Tee connector", 2 });
+    }
+
+    void getCutPieces(vector<CutPiece>& out) const override {
+        cut(out, "D54", 1, length, "L");
+        cut(out, "D41", 1, length, "L");
+        if (includeTee) {
+            cut(out, "D52", 1, tee, "T");
+            cut(out, "D41", 2, tee, "T");
+        }
+    }
+
+    float calculateTotalPrice(const map<string, float>& rates) const override {
+        const auto& sections = requiredSections();
+        float total = 0;
+
+        for (const auto& s : sections) {
+            float inches = s.second;
+            float roundedFeet = roundToMarketFeet(inches);
+
+            float rate;
+            if (!findRate(rates, s.first, rate)) continue;
+            float price = roundedFeet * rate;
+
+            total += price;
+
+            printSectionLine(s.first, inches, roundedFeet, price);
+        }
+
+        Report::out().done();
+        return total;
+    }
+
+    float roundToMarketFeet(float inches) const override {
+        float ft = inches / 12.0f;
+        int whole = static_cast<int>(floor(ft));
+        float inch = (ft - whole) * 12;
+        return (inch <= 6.0f) ? (whole + 0.6f) : (whole + 1.0f);
+    }
+};
+
+/////////////////////////////////////////////////////////
+// 🪟 Openable window with or without net
+/////////////////////////////////////////////////////////
+
+class OpenableWindow : public FrameComponent {
+    float height = 0, width = 0;
+    int collerType = 1;
+    bool hasNet = false;
+
+public:
+    void inputDimensions() override {
+        char netChoice;
+        cout << "Do you want net in this Openable Window? (y/n): ";
+        cin >> netChoice;
+        hasNet = (netChoice == 'y' || netChoice == 'Y');
+
+        do {
+            cout << "Enter Coller Type (1 to 14): ";
+            cin >> collerType;
+        } while (collerType < 1 || collerType > 14);
+
+        do {
+            cout << "Enter height " << kSizeUnits << ": ";
+            cin >> asSize(height, "h");
+        } while (rejected(cin) || height <= 0);
+
+        do {
+            cout << "Enter width " << kSizeUnits << ": ";
+            cin >> asSize(width, "w");
+        } while (rejected(cin) || width <= 0);
+        invalidateSections();
+    }
+
+    void loadSpec(const WindowSpec& spec) override {
+        hasNet = spec.hasNet;
+        collerType = spec.collar;
+        height = spec.height;
+        width = spec.width;
+        invalidateSections();
+    }
+
+    WindowSpec getSpec() const override {
+        WindowSpec spec;
+        spec.hasNet = hasNet;
+        spec.collar = collerType;
+        spec.height = height;
+        spec.width = width;
+        return spec;
+    }
+
+    void displayType() const override {
+        Report& out = Report::out();
+        out << "Openable Window (" << (hasNet ? "with Net" : "without Net") << ")\n";
+        out.done();
+    }
+
+    float getArea() const override {
+        return (height / 12.0f) * (width / 12.0f);
+    }
+
+    map<string, float> getRequiredSections() const override {
+        map<string, float> sections;
+        float h = height, w = width;
+
+        // Coller based section formula
+        static const string names[] = { "D54F", "D54A" };
+        CollarRules::apply(CollarRules::fixed, collerType, h, w, names, sections);
+
+        // Net logic
+        sections["D50"] = (h + w) * 2;
+        if (hasNet) {
+            sections["D29"] = (h + w) * 2;
+        }
+
+        return sections;
+    }
+
+    vector<NetPanel> getNetPanels() const override {
+        if (!hasNet) return {};
+        return { { height, width } };
+    }
+
+    void getHardware(vector<HardwareLine>& kit) const override {
+        FrameComponent::getHardware(kit);
+        kit.push_back({ "Friction stay (pair)", 1 });
+        kit.push_back({ "Casement handle", 1 });
+        if (hasNet) kit.push_back({ "Net clip", 4 });
+    }
+
+    void getCutPieces(vector<CutPiece>& out) const override {
+        static const string names[] = { "D54F", "D54A" };
+        CollarRules::cuts(CollarRules::fixed, collerType, height, width, names, out);
+
+        cut(out, "D50", 2, height, "H");
+        cut(out, "D50", 2, width, "W");
+        if (hasNet) {
+            cut(out, "D29", 2, height, "H");
+            cut(out, "D29", 2, width, "W");
+        }
+    }
+
+    float calculateTotalPrice(const map<string, float>& rates) const override {
+        const auto& sections = requiredSections();
+        float total = 0;
+
+        for (const auto& s : sections) {
+            float rate;
+            if (!findRate(rates, s.first, rate)) continue;
+
+            float inches = s.second;
+            float roundedFeet = roundToMarketFeet(inches);
+            float price = roundedFeet * rate;
+
+            total += price;
+
+            printSectionLine(s.first, inches, roundedFeet, price);
+        }
+
+        Report::out().done();
+        return total;
+    }
+
+    float roundToMarketFeet(float inches) const override {
+        float ft = inches / 12.0f;
+        int whole = static_cast<int>(floor(ft));
+        float inch = (ft - whole) * 12;
+
+        return (inch <= 6.0f) ? (whole + 0.6f) : (whole + 1.0f);
+    }
+};
+
+/////////////////////////////////////////////////////////
+// 🪟 Door/Double Door with Divider and Tee or Not
+/////////////////////////////////////////////////////////
+
+class DoorWindow : public FrameComponent {
+    float height = 0, width = 0, tee = 0;
+    int collerType = 1;
+    bool includeD46 = false;
+    bool includeTee = false;
+    bool isDouble = false; // 👈 New flag
+
+public:
+    DoorWindow(bool doubleDoor = false) : isDouble(doubleDoor) {}
+
+    void inputDimensions() override {
+        char ans;
+        cout << "Do you want to include bottom section D46? (y/n): ";
+        cin >> ans;
+        includeD46 = (ans == 'y' || ans == 'Y');
+
+        cout << "Do you want to include a Tee (divider)? (y/n): ";
+        cin >> ans;
+        includeTee = (ans == 'y' || ans == 'Y');
+
+        if (includeTee) {
+            do {
+                cout << "Enter Tee length " << kSizeUnits << ": ";
+                cin >> asInches(tee);
+            } while (rejected(cin) || tee <= 0);
+        }
+
+        do {
+            cout << "Enter collar type (1–8): ";
+            cin >> collerType;
+        } while (collerType < 1 || collerType > 8);
+
+        do {
+            cout << "Enter height " << kSizeUnits << ": ";
+            cin >> asSize(height, "h");
+        } while (rejected(cin) || height <= 0);
+
+        do {
+            cout << "Enter width " << kSizeUnits << ": ";
+            cin >> asSize(width, "w");
+        } while (rejected(cin) || width <= 0);
+        invalidateSections();
+    }
+
+    void loadSpec(const WindowSpec& spec) override {
+        includeD46 = spec.includeD46;
+        includeTee = spec.includeTee;
+        tee = spec.tee;
+        collerType = spec.collar;
+        height = spec.height;
+        width = spec.width;
+        invalidateSections();
+    }
+
+    WindowSpec getSpec() const override {
+        WindowSpec spec;
+        spec.includeD46 = includeD46;
+        spec.includeTee = includeTee;
+        spec.tee = tee;
+        spec.collar = collerType;
+        spec.height = height;
+        spec.width = width;
+        return spec;
+    }
+
+    void displayType() const override {
+        Report& out = Report::out();
+        out << (isDouble ? "🚪 Double Door\n" : "🚪 Single Door\n");
+        out.done();
+    }
+
+    float getArea() const override {
+        return (height / 12.0f) * (width / 12.0f);
+    }
+
+    map<string, float> getRequiredSections() const override {
+        map<string, float> sections;
+        float h = height, w = width, t = tee;
+
+        // D54F and D54A
+        static const string names[] = { "D54F", "D54A" };
+        CollarRules::apply(CollarRules::door, collerType, h, w, names, sections);
+
+        // D50 and D46 logic updated for double door
+        if (includeD46) {
+            sections["D46"] = w;
+            sections["D50"] = isDouble ? (h * 4) + w : (h * 2) + w;
+        } else {
+            sections["D50"] = isDouble ? (h * 4) + (w * 2) : (h + w) * 2;
+        }
+
+        // Optional Tee
+        if (includeTee) {
+            sections["D52"] = t;
+        }
+
+        return sections;
+    }
+
+    void getHardware(vector<HardwareLine>& kit) const override {
+        FrameComponent::getHardware(kit);
+        float leaves = isDouble ? 2 : 1;
+        kit.push_back({ "Door hinge", (height > 84 ? 4 : 3) * leaves });
+        kit.push_back({ "Mortise lock", 1 });
+        kit.push_back({ "Door handle set", 1 });
+        kit.push_back({ "Door stopper", leaves });
+        if (isDouble) kit.push_back({ "Tower bolt", 2 });
+        if (includeD46) kit.push_back({ "Bottom seal (ft)", width / 12 });
+        if (includeTee) kit.push_back({ "Tee connector", 2 });
+    }
+
+    void getCutPieces(vector<CutPiece>& out) const override {
+        static const string names[] = { "D54F", "D54A" };
+        CollarRules::cuts(CollarRules::door, collerType, height, width, names, out);
+
+        // Stiles per leaf; D46 replaces the bottom rail when fitted.
+        cut(out, "D50", isDouble ? 4 : 2, height, "H");
+        cut(out, "D50", includeD46 ? 1 : 2, width, "W");
+        if (includeD46) cut(out, "D46", 1, width, "W");
+        if (includeTee) cut(out, "D52", 1, tee, "T");
+    }
+
+    float calculateTotalPrice(const map<string, float>& rates) const override {
+        const auto& sections = requiredSections();
+        float total = 0;
+
+        for (const auto& s : sections) {
+            float inches = s.second;
+            float roundedFeet = roundToMarketFeet(inches);
+            float rate;
+            if (!findRate(rates, s.first, rate)) continue;
+            float price = roundedFeet * rate;
+            total += price;
+
+            printSectionLine(s.first, inches, roundedFeet, price);
+        }
+
+        Report::out().done();
+        return total;
+    }
+
+    float roundToMarketFeet(float inches) const override {
+        float ft = inches / 12.0f;
+        int whole = static_cast<int>(floor(ft));
+        float inch = (ft - whole) * 12;
+        return (inch <= 6.0f) ? whole + 0.6f : whole + 1.0f;
+    }
+};
+
+/////////////////////////////////////////////////////////
+// 📐 Arch Geometry (arc length and glass area from span and rise)
+/////////////////////////////////////////////////////////
+
+enum class ArchShape { Manual = 0, Semicircular = 1, Segmental = 2, Elliptical = 3 };
+
+struct ArchGeometry {
+    static constexpr double kPi = 3.14159265358979323846;
+
+    // Circular arc through both springing points and the crown. The central
+    // angle is 4 * atan(2 * rise / span), valid for any rise > 0.
+    static float circularLength(float span, float rise) {
+        if (rise <= 0) return span;
+        double c = span, h = rise;
+        double radius = (c * c / 4 + h * h) / (2 * h);
+        double angle = 4 * atan(2 * h / c);
+        return static_cast<float>(radius * angle);
+    }
+
+    static float circularArea(float span, float rise) {
+        if (rise <= 0) return 0;
+        double c = span, h = rise;
+        double radius = (c * c / 4 + h * h) / (2 * h);
+        double angle = 4 * atan(2 * h / c);
+        return static_cast<float>(radius * radius / 2 * (angle - sin(angle)));
+    }
+
+    // Half the perimeter of an ellipse with semi-axes span/2 and rise
+    // (Ramanujan's second approximation, well under 0.01% off for arches).
+    static float ellipticalLength(float span, float rise) {
+        double a = span / 2.0, b = rise;
+        if (a + b <= 0) return 0;
+        double q = (a - b) * (a - b) / ((a + b) * (a + b));
+        return static_cast<float>(kPi * (a + b) * (1 + 3 * q / (10 + sqrt(4 - 3 * q))) / 2);
+    }
+
+    static float ellipticalArea(float span, float rise) {
+        return static_cast<float>(kPi * (span / 2.0) * rise / 2);
+    }
+
+    // Length of the curved member (inches).
+    static float length(ArchShape shape, float span, float rise) {
+        switch (shape) {
+            case ArchShape::Semicircular: return circularLength(span, span / 2);
+            case ArchShape::Segmental:    return circularLength(span, rise);
+            case ArchShape::Elliptical:   return ellipticalLength(span, rise);
+            default:                      return 0;
+        }
+    }
+
+    // Glass between the arch and its springing line (square inches).
+    static float area(ArchShape shape, float span, float rise) {
+        switch (shape) {
+            case ArchShape::Semicircular: return circularArea(span, span / 2);
+            case ArchShape::Segmental:    return circularArea(span, rise);
+            case ArchShape::Elliptical:   return ellipticalArea(span, rise);
+            default:                      return 0;
+        }
+    }
+};
+
+/////////////////////////////////////////////////////////
+// 🪟 Qadial Arch Window
+/////////////////////////////////////////////////////////
+
+class QadialArchWindow : public FrameComponent {
+    float height = 0, width = 0, T = 0, rise = 0;  // rise 0 = flat top
+    int collerType = 1;
+    bool includeTee = false;
+
+public:
+    void inputDimensions() override {
+        do {
+            cout << "Enter Coller Type (1 to 8): ";
+            cin >> collerType;
+        } while (collerType < 1 || collerType > 8);
+
+        do {
+            cout << "Enter height " << kSizeUnits << ": ";
+            cin >> asSize(height, "h");
+        } while (rejected(cin) || height <= 0);
+
+        do {
+            cout << "Enter width " << kSizeUnits << ": ";
+            cin >> asSize(width, "w");
+        } while (rejected(cin) || width <= 0);
+
+        do {
+            cout << "Enter arch rise at the top " << kSizeUnits << ", 0 for flat top: ";
+            cin >> asInches(rise);
+        } while (rejected(cin) || rise < 0 || rise > height);
+
+        cout << "Do you want to include Tee/Divider (1 = Yes, 0 = No)? ";
+        cin >> includeTee;
+        if (includeTee) {
+            do {
+                cout << "Enter Tee (Divider) length " << kSizeUnits << ": ";
+                cin >> asInches(T);
+            } while (rejected(cin) || T <= 0);
+        }
+        invalidateSections();
+    }
+
+    // Project-file rule beyond the type's inputs; "" when the spec is fine.
+    static string checkSpec(const WindowSpec& s) {
+        return s.rise < 0 || s.rise > s.height ? "rise must be between 0 and the height" : "";
+    }
+
+    void loadSpec(const WindowSpec& spec) override {
+        collerType = spec.collar;
+        height = spec.height;
+        width = spec.width;
+        rise = spec.rise;
+        includeTee = spec.includeTee;
+        T = spec.tee;
+        invalidateSections();
+    }
+
+    WindowSpec getSpec() const override {
+        WindowSpec spec;
+        spec.collar = collerType;
+        spec.height = height;
+        spec.width = width;
+        spec.rise = rise;
+        spec.includeTee = includeTee;
+        spec.tee = T;
+        return spec;
+    }
+
+    void displayType() const override {
+        Report& out = Report::out();
+        out << "Qadial Arch (4-corner) Window\n";
+        out.done();
+    }
+
+    float getArea() const override {
+        // Rectangle up to the springing line plus the segmental top
+        float below = max(0.0f, height - rise) * width;
+        return (below + ArchGeometry::circularArea(width, rise)) / 144.0f; // Area in sq ft
+    }
+
+    map<string, float> getRequiredSections() const override {
+        map<string, float> sections;
+        float h = height, w = width;
+
+        static const string names[] = { "D50F", "D50A" };
+        CollarRules::apply(CollarRules::qadial, collerType, h, w, names, sections);
+
+        // Handle optional Tee
+        if (includeTee) {
+            sections["D40"] = T;
+            sections["D41"] = ((h + w) * 2) + (T * 2);
+        } else {
+            sections["D41"] = (h + w) * 2;
+        }
+
+        return sections;
+    }
+
+    void getHardware(vector<HardwareLine>& kit) const override {
+        FrameComponent::getHardware(kit);
+        if (includeTee) kit.push_back({ "Tee connector", 2 });
+    }
+
+    void getCutPieces(vector<CutPiece>& out) const override {
+        static const string names[] = { "D50F", "D50A" };
+        CollarRules::cuts(CollarRules::qadial, collerType, height, width, names, out);
+
+        cut(out, "D41", 2, height, "H");
+        cut(out, "D41", 2, width, "W");
+        if (includeTee) {
+            cut(out, "D40", 1, T, "T");
+            cut(out, "D41", 2, T, "T");
+        }
+    }
+
+    float calculateTotalPrice(const map<string, float>& rates) const override {
+        const auto& sections = requiredSections();
+        float total = 0;
+
+        for (const auto& s : sections) {
+            float inches = s.second;
+            float roundedFeet = roundToMarketFeet(inches);
+            float rate;
+            if (!findRate(rates, s.first, rate)) continue;
+            float price = roundedFeet * rate;
+            total += price;
+
+            printSectionLine(s.first, inches, roundedFeet, price);
+        }
+
+        Report::out().done();
+        return total;
+    }
+
+    float roundToMarketFeet(float inches) const override {
+        float ft = inches / 12.0f;
+        int whole = static_cast<int>(floor(ft));
+        float inchPart = (ft - whole) * 12;
+
+        return inchPart <= 6.0f ? (whole + 0.6f) : (whole + 1.0f);
+    }
+};
+
+
+/////////////////////////////////////////////////////////
+// 🪟 Round Top Arch Window
+/////////////////////////////////////////////////////////
+
+class RoundArchWindow : public FrameComponent {
+    float width = 0, arch = 0, T = 0, height = 0;
+    int shape = 0;  // ArchShape; Manual keeps the typed arch length and height
+    bool hasColler = false;
+    bool includeTee = false;
+
+    // For drawn shapes the arch member and the glass come from width and rise.
+    void updateGeometry() {
+        ArchShape s = static_cast<ArchShape>(shape);
+        if (s == ArchShape::Manual) return;
+        if (s == ArchShape::Semicircular) height = width / 2;
+        arch = ArchGeometry::length(s, width, height);
+    }
+
+public:
+    void inputDimensions() override {
+        cout << "Does the window have a coller? (1 = Yes, 0 = No): ";
+        cin >> hasColler;
+
+        do {
+            cout << "Arch shape (1 = Semicircular, 2 = Segmental, 3 = Elliptical, 0 = Enter arch length): ";
+            cin >> shape;
+        } while (shape < 0 || shape > 3);
+
+        if (shape == 0) {
+            do {
+                cout << "Enter Arch length " << kSizeUnits << ": ";
+                cin >> asInches(arch);
+            } while (rejected(cin) || arch <= 0);
+        }
+
+        do {
+            cout << "Enter window width " << kSizeUnits << ": ";
+            cin >> asSize(width, "w");
+        } while (rejected(cin) || width <= 0);
+
+        if (shape == 0) {
+            do {
+                cout << "Enter approximate height for area calculation (used only for glass/labor): ";
+                cin >> asSize(height, "h");
+            } while (rejected(cin) || height <= 0);
+        } else if (shape != 1) {
+            do {
+                cout << "Enter arch rise (height of the crown above the springing line) " << kSizeUnits << ": ";
+                cin >> asInches(height);
+            } while (rejected(cin) || height <= 0);
+        }
+
+        updateGeometry();
+        if (shape != 0)
+            cout << fixed << setprecision(2) << "Arch length: " << arch << " inches\n";
+
+        cout << "Do you want to add a Tee/Divider? (1 = Yes, 0 = No): ";
+        cin >> includeTee;
+
+        if (includeTee) {
+            do {
+                cout << "Enter Tee (Divider) size " << kSizeUnits << ": ";
+                cin >> asInches(T);
+            } while (rejected(cin) || T <= 0);
+        }
+        invalidateSections();
+    }
+
+    // Project-file rules beyond the type's inputs, as the prompts ask them.
+    static string checkSpec(const WindowSpec& s) {
+        if (s.archShape < 0 || s.archShape > 3) return "arch shape must be 0 to 3";
+        if (s.archShape == 0 && s.arch <= 0) return "arch must be greater than 0";
+        if ((s.archShape == 2 || s.archShape == 3) && s.rise <= 0) return "rise must be greater than 0";
+        return "";
+    }
+
+    void loadSpec(const WindowSpec& spec) override {
+        hasColler = spec.hasColler;
+        // Specs come from files too; a shape this build does not know is
+        // priced from the stored arch length and height, like Manual.
+        bool known = spec.archShape >= static_cast<int>(ArchShape::Manual) &&
+                     spec.archShape <= static_cast<int>(ArchShape::Elliptical);
+        shape = known ? spec.archShape : static_cast<int>(ArchShape::Manual);
+        arch = spec.arch;
+        width = spec.width;
+        height = shape == 0 ? spec.height : spec.rise;
+        includeTee = spec.includeTee;
+        T = spec.tee;
+        updateGeometry();
+        invalidateSections();
+    }
+
+    // A drawn arch's height is its rise, loaded from spec.rise.
+    bool drivesHeight() const override { return shape == 0; }
+
+    WindowSpec getSpec() const override {
+        WindowSpec spec;
+        spec.hasColler = hasColler;
+        spec.archShape = shape;
+        spec.arch = arch;
+        spec.width = width;
+        spec.height = height;
+        if (shape != 0) spec.rise = height;
+        spec.includeTee = includeTee;
+        spec.tee = T;
+        return spec;
+    }
+
+    void displayType() const override {
+        Report& out = Report::out();
+        static const char* const shapes[] = { "", " (Semicircular)", " (Segmental)", " (Elliptical)" };
+        out << "Round Arch Window" << shapes[shape] << "\n";
+        out.done();
+    }
+
+    float getArea() const override {
+        if (shape == 0)
+            return (height / 12.0f) * (width / 12.0f);  // 👈 used only for square footage
+        return ArchGeometry::area(static_cast<ArchShape>(shape), width, height) / 144.0f;
+    }
+
+    map<string, float> getRequiredSections() const override {
+        map<string, float> sections;
+        float w = width;
+
+        if (hasColler) {
+            sections["D50F"] = arch + 12;
+            sections["D50A"] = w;
+        } else {
+            sections["D50A"] = arch + w + 12;
+        }
+
+        if (includeTee) {
+            sections["D40"] = T;
+            sections["D41"] = arch + w + 12 + (T * 2);
+        } else {
+            sections["D41"] = arch + w + 12;
+        }
+
+        return sections;
+    }
+
+    void getHardware(vector<HardwareLine>& kit) const override {
+        FrameComponent::getHardware(kit);
+        if (includeTee) kit.push_back({ "Tee connector", 2 });
+    }
+
+    // The arch is bent from one length with 12" for the bend.
+    void getCutPieces(vector<CutPiece>& out) const override {
+        cut(out, hasColler ? "D50F" : "D50A", 1, arch + 12, "Arch+12");
+        cut(out, "D50A", 1, width, "W");
+
+        cut(out, "D41", 1, arch + 12, "Arch+12");
+        cut(out, "D41", 1, width, "W");
+        if (includeTee) {
+            cut(out, "D40", 1, T, "T");
+            cut(out, "D41", 2, T, "T");
+        }
+    }
+
+    float calculateTotalPrice(const map<string, float>& rates) const override {
+        const auto& sections = requiredSections();
+        float total = 0;
+
+        for (const auto& s : sections) {
+            float inches = s.second;
+            float roundedFeet = roundToMarketFeet(inches);
+            float rate;
+            if (!findRate(rates, s.first, rate)) continue;
+            float price = roundedFeet * rate;
+            total += price;
+
+            printSectionLine(s.first, inches, roundedFeet, price);
+        }
+
+        Report::out().done();
+        return total;
+    }
+
+    float roundToMarketFeet(float inches) const override {
+        float ft = inches / 12.0f;
+        int whole = static_cast<int>(floor(ft));
+        float inchPart = (ft - whole) * 12;
+
+        return inchPart <= 6.0f ? (whole + 0.6f) : (whole + 1.0f);
+    }
+};
+
+/////////////////////////////////////////////////////////
+// 🪟 Fix Coner Window
+/////////////////////////////////////////////////////////
+
+class FixCornerWindow : public FrameComponent {
+    float h = 0, wl = 0, wr = 0, T = 0;
+    bool coller = false;
+    bool includeTee = false;
+
+public:
+    void inputDimensions() override {
+        cout << "Does this corner window have a coller? (1 = Yes, 0 = No): ";
+        cin >> coller;
+
+        do {
+            cout << "Enter Height " << kSizeUnits << ": ";
+            cin >> asSize(h, "h");
+        } while (rejected(cin) || h <= 0);
+
+        do {
+            cout << "Enter Left Width " << kSizeUnits << ": ";
+            cin >> asSize(wl, "w");
+        } while (rejected(cin) || wl <= 0);
+
+        do {
+            cout << "Enter Right Width " << kSizeUnits << ": ";
+            cin >> asSize(wr, "wr");
+        } while (rejected(cin) || wr <= 0);
+
+        cout << "Do you want to add a Tee/Divider? (1 = Yes, 0 = No): ";
+        cin >> includeTee;
+
+        if (includeTee) {
+            do {
+                cout << "Enter Tee size " << kSizeUnits << ": ";
+                cin >> asInches(T);
+            } while (rejected(cin) || T <= 0);
+        }
+        invalidateSections();
+    }
+
+    void loadSpec(const WindowSpec& spec) override {
+        coller = spec.hasColler;
+        h = spec.height;
+        wl = spec.width;
+        wr = spec.widthRight;
+        includeTee = spec.includeTee;
+        T = spec.tee;
+        invalidateSections();
+    }
+
+    WindowSpec getSpec() const override {
+        WindowSpec spec;
+        spec.hasColler = coller;
+        spec.height = h;
+        spec.width = wl;
+        spec.widthRight = wr;
+        spec.includeTee = includeTee;
+        spec.tee = T;
+        return spec;
+    }
+
+    void displayType() const override {
+        Report& out = Report::out();
+        out << "Fix Corner Window\n";
+        out.done();
+    }
+
+    float getArea() const override {
+        float totalWidth = wl + wr;
+        return (h / 12.0f) * (totalWidth / 12.0f);  // Just for glass/labor estimation
+    }
+
+    int cornerJoints() const override {
+        return 6;  // two frames sharing the corner post
+    }
+
+    map<string, float> getRequiredSections() const override {
+        map<string, float> sections;
+
+        if (coller)
+            sections["D54F"] = (h * 2) + ((wl + wr) * 2) + 18;
+        else
+            sections["D54A"] = (h * 2) + ((wl + wr) * 2);
+
+        if (includeTee) {
+            sections["D40"] = T;
+            sections["D41"] = (h * 2) + ((wl + wr) * 2) + (T * 2);
+        } else {
+            sections["D41"] = (h * 2) + ((wl + wr) * 2);
+        }
+
+        return sections;
+    }
+
+    void getHardware(vector<HardwareLine>& kit) const override {
+        FrameComponent::getHardware(kit);
+        kit.push_back({ "Corner connector", 1 });
+        if (includeTee) kit.push_back({ "Tee connector", 2 });
+    }
+
+    void getCutPieces(vector<CutPiece>& out) const override {
+        string frame = coller ? "D54F" : "D54A";
+        cut(out, frame, 2, h, "H");
+        cut(out, frame, 2, wl, "WL");
+        cut(out, frame, 2, wr, "WR");
+        if (coller) { out.back().length += 18; out.back().label += "+18"; }
+
+        cut(out, "D41", 2, h, "H");
+        cut(out, "D41", 2, wl, "WL");
+        cut(out, "D41", 2, wr, "WR");
+        if (includeTee) {
+            cut(out, "D40", 1, T, "T");
+            cut(out, "D41", 2, T, "T");
+        }
+    }
+
+    float calculateTotalPrice(const map<string, float>& rates) const override {
+        const auto& sections = requiredSections();
+        float total = 0;
+
+        for (const auto& s : sections) {
+            float inches = s.second;
+            float roundedFeet = roundToMarketFeet(inches);
+            float rate;
+            if (!findRate(rates, s.first, rate)) continue;
+            float price = roundedFeet * rate;
+            total += price;
+
+            printSectionLine(s.first, inches, roundedFeet, price);
+        }
+
+        Report::out().done();
+        return total;
+    }
+
+    float roundToMarketFeet(float inches) const override {
+        float ft = inches / 12.0f;
+        int whole = static_cast<int>(floor(ft));
+        float inchPart = (ft - whole) * 12;
+        return (inchPart <= 6.0f) ? (whole + 0.6f) : (whole + 1.0f);
+    }
+};
+
+/////////////////////////////////////////////////////////
+// 🪟 Slide Corner Window
+/////////////////////////////////////////////////////////
+
+class SlideCornerWindow : public FrameComponent {
+    float height = 0, wl = 0, wr = 0, d29Width = 0;
+    int subtype = 1;
+    bool includeD29 = true;
+    bool useColler = true;
+    string sec30, sec26;
+
+public:
+    SlideCornerWindow(bool d29, string s30, string s26)
+        : includeD29(d29), sec30(s30), sec26(s26) {}
+
+    void inputDimensions() override {
+        cout << "\n--- Slide Corner Window ---\n";
+        cout << "Select subtype:\n";
+        cout << "1. Left Side Fix Corner\n";
+        cout << "2. Right Side Fix Corner\n";
+        cout << "3. Center Fix Corner\n";
+        cout << "4. Center Fix (Far) Corner\n";
+        cout << "5. Center Slide Corner\n";
+        cin >> subtype;
+
+        cout << "Do you want to use coller style? (1 = Yes, 0 = No): ";
+        cin >> useColler;
+
+        do {
+            cout << "Enter Height " << kSizeUnits << ": ";
+            cin >> asSize(height, "h");
+        } while (rejected(cin) || height <= 0);
+
+        do {
+            cout << "Enter Width (Left side) " << kSizeUnits << ": ";
+            cin >> asSize(wl, "w");
+        } while (rejected(cin) || wl <= 0);
+
+        do {
+            cout << "Enter Width (Right side) " << kSizeUnits << ": ";
+            cin >> asSize(wr, "wr");
+        } while (rejected(cin) || wr <= 0);
+
+        if (subtype == 4 && includeD29) {
+            do {
+                cout << "Enter custom width for D29 " << kSizeUnits << ": ";
+                cin >> asInches(d29Width);
+            } while (rejected(cin) || d29Width <= 0);
+        }
+        invalidateSections();
+    }
+
+    // Subtype 4 needs the D29 width; only the D29 version registers this.
+    static string checkSpec(const WindowSpec& s) {
+        return s.collar == 4 && s.netWidth <= 0 ? "netwidth (D29 width) must be greater than 0" : "";
+    }
+
+    void loadSpec(const WindowSpec& spec) override {
+        subtype = spec.collar;
+        useColler = spec.hasColler;
+        height = spec.height;
+        wl = spec.width;
+        wr = spec.widthRight;
+        d29Width = spec.netWidth;
+        invalidateSections();
+    }
+
+    WindowSpec getSpec() const override {
+        WindowSpec spec;
+        spec.collar = subtype;
+        spec.hasColler = useColler;
+        spec.height = height;
+        spec.width = wl;
+        spec.widthRight = wr;
+        spec.netWidth = d29Width;
+        return spec;
+    }
+
+    void displayType() const override {
+        Report& out = Report::out();
+        out << "Slide Corner Window - ";
+        switch (subtype) {
+            case 1: out << "Left Side Fix\n"; break;
+            case 2: out << "Right Side Fix\n"; break;
+            case 3: out << "Center Fix\n"; break;
+            case 4: out << "Center Fix (Far)\n"; break;
+            case 5: out << "Center Slide\n"; break;
+        }
+        out.done();
+    }
+
+    float getArea() const override {
+        return (height / 12.0f) * ((wl + wr) / 12.0f);
+    }
+
+    int cornerJoints() const override {
+        return 6;  // two frames sharing the corner post
+    }
+
+    map<string, float> getRequiredSections() const override {
+        map<string, float> sections;
+        string suffix30 = useColler ? "F" : "A";
+        string suffix26 = useColler ? "F" : "A";
+        string sec30Full = sec30 + suffix30;
+        string sec26Full = sec26 + suffix26;
+
+        float c30Add = useColler ? 12.0f : 0.0f;
+        float c26Add = useColler ? 6.0f : 0.0f;
+
+        if (subtype == 1) {  // Left Side Fix
+            sections[sec30Full] = ((height + wl + wr) * 2) + c30Add;
+            sections[sec26Full] = wl + wr + c26Add;
+            if (includeD29) sections["D29"] = (height * 2) + wr;
+        }
+        else if (subtype == 2) {  // Right Side Fix
+            sections[sec30Full] = ((height + wl + wr) * 2) + c30Add;
+            sections[sec26Full] = wl + wr + c26Add;
+            if (includeD29) sections["D29"] = (height * 2) + wl;
+        }
+        else if (subtype == 3) {  // Center Fix
+            sections[sec30Full] = (height * 2) + wl + wr + c30Add;
+            sections[sec26Full] = wl + wr + c26Add;
+            if (includeD29) sections["D29"] = (height * 4) + wl + wr;
+        }
+        else if (subtype == 4) {  // Center Fix (Far)
+            sections[sec30Full] = (height * 2) + wl + wr + c30Add;
+            sections[sec26Full] = wl + wr + c26Add;
+            if (includeD29) sections["D29"] = (height * 4) + (d29Width * 4);
+        }
+        else if (subtype == 5) {  // Center Slide
+            sections[sec30Full] = (height * 2) + wl + wr + c30Add;
+            sections[sec26Full] = wl + wr + c26Add;
+            if (includeD29) sections["D29"] = (height * 4) + wl + wr;
+        }
+
+        sections["M23"] = height * ((subtype == 5) ? 4 : 2);
+        sections["M28"] = height * ((subtype == 1 || subtype == 2) ? 2 : 4);
+        sections["M24"] = (wl + wr) * 2;
+
+        return sections;
+    }
+
+    // Sliding sashes are half a side wide; D29 lengths above frame them.
+    vector<NetPanel> getNetPanels() const override {
+        if (!includeD29) return {};
+        switch (subtype) {
+            case 1: return { { height, wr / 2 } };
+            case 2: return { { height, wl / 2 } };
+            case 3: case 5: return { { height, wl / 2 }, { height, wr / 2 } };
+            case 4: return { { height, d29Width }, { height, d29Width } };
+        }
+        return {};
+    }
+
+    // Side-fix subtypes slide on one side only.
+    void getHardware(vector<HardwareLine>& kit) const override {
+        FrameComponent::getHardware(kit);
+        float glass = (subtype == 1 || subtype == 2) ? 2 : 4;
+        float sashes = glass + static_cast<float>(getNetPanels().size());
+        kit.push_back({ "Sliding roller", 2 * sashes });
+        kit.push_back({ "Crescent lock", glass / 2 });
+        kit.push_back({ "Weather brush (ft)", 2 * height * sashes / 12 });
+        kit.push_back({ "Corner connector", 1 });
+    }
+
+    void getCutPieces(vector<CutPiece>& out) const override {
+        string sec30Full = sec30 + (useColler ? "F" : "A");
+        string sec26Full = sec26 + (useColler ? "F" : "A");
+        bool sideFix = (subtype == 1 || subtype == 2);
+        if (subtype < 1 || subtype > 5) return;
+
+        cut(out, sec30Full, 2, height, "H");
+        cut(out, sec30Full, sideFix ? 2 : 1, wl, "WL");
+        cut(out, sec30Full, sideFix ? 2 : 1, wr, "WR");
+        if (useColler) { out.back().length += 12; out.back().label += "+12"; }
+        cut(out, sec26Full, 1, wl, "WL");
+        cut(out, sec26Full, 1, wr, "WR");
+        if (useColler) { out.back().length += 6; out.back().label += "+6"; }
+
+        if (includeD29) {
+            for (const NetPanel& p : getNetPanels()) {
+                cut(out, "D29", 2, p.height, "H");
+                cut(out, "D29", 2, p.width, subtype == 4 ? "N" : "W/2");
+            }
+        }
+
+        cut(out, "M23", subtype == 5 ? 4 : 2, height, "H");
+        cut(out, "M28", sideFix ? 2 : 4, height, "H");
+        cut(out, "M24", 2, wl, "WL");
+        cut(out, "M24", 2, wr, "WR");
+    }
+
+    float calculateTotalPrice(const map<string, float>& rates) const override {
+        const auto& sections = requiredSections();
+        float total = 0;
+
+        for (const auto& s : sections) {
+            float inches = s.second;
+            float roundedFeet = roundToMarketFeet(inches);
+            float rate;
+            if (!findRate(rates, s.first, rate)) continue;
+            float price = roundedFeet * rate;
+            total += price;
+
+            printSectionLine(s.first, inches, roundedFeet, price);
+        }
+
+        Report::out().done();
+        return total;
+    }
+
+    float roundToMarketFeet(float inches) const override {
+        float ft = inches / 12.0f;
+        int whole = static_cast<int>(floor(ft));
+        float inch = (ft - whole) * 12;
+
+        return (inch <= 6.0f) ? (whole + 0.6f) : (whole + 1.0f);
+    }
+};
+
+/////////////////////////////////////////////////////////
+// 🪟 Bay Window (any number of corner-joined segments)
+/////////////////////////////////////////////////////////
+
+// Fix and slide corner windows generalised to N segments, each fixed (F)
+// or sliding (S). Neighbouring segments share a corner post, so only the
+// two outer jambs are cut from the frame profile and each shared joint
+// adds a corner connector instead of two more jambs. Every section is one
+// pass over the segments, O(N).
+//
+// All-fixed bays use the fix corner profiles (D54/D41, optional tee).
+// Anything with a sliding segment uses the slide corner profiles; with two
+// segments this gives the same lengths as Fix Corner and Slide Corner
+// subtypes 1, 2 and 5.
+class BayWindow : public FrameComponent {
+    float height = 0, T = 0;
+    vector<float> widths;
+    vector<char> sliding;  // per segment
+    bool coller = false;
+    bool includeTee = false;
+
+    float totalWidth() const {
+        float w = 0;
+        for (float x : widths) w += x;
+        return w;
+    }
+
+    int slidingCount() const {
+        int n = 0;
+        for (char s : sliding) n += s;
+        return n;
+    }
+
+    static string label(size_t i) { return "W" + to_string(i + 1); }
+
+public:
+    static constexpr int kMaxSegments = 8;
+
+    // "F36,S1200mm,F3'": a role letter, then a size in any unit Units reads.
+    // Every segment needs a width above 0, and a bay has 2 to kMaxSegments.
+    static bool parseSegments(const string& text, vector<float>& widths, vector<char>& sliding,
+                              Units::Unit unit = Units::Inch) {
+        widths.clear();
+        sliding.clear();
+        size_t begin = 0;
+        while (begin < text.size()) {
+            size_t end = min(text.find(',', begin), text.size());
+            string_view item(text.data() + begin, end - begin);
+            begin = end + 1;
+
+            char role = item.empty() ? 0 : static_cast<char>(toupper(static_cast<unsigned char>(item[0])));
+            if (role != 'F' && role != 'S') return false;
+            float inches = 0;
+            if (item.size() < 2 || !Units::parse(item.substr(1), inches, unit) || !(inches > 0)) return false;
+            widths.push_back(inches);
+            sliding.push_back(role == 'S');
+        }
+        return widths.size() >= 2 && widths.size() <= kMaxSegments;
+    }
+
+    // Roles only, "F,S,F": a bay's layout before its widths are chosen.
+    static bool parseRoles(const string& text, vector<char>& sliding) {
+        sliding.clear();
+        size_t begin = 0;
+        while (begin < text.size()) {
+            size_t end = min(text.find(',', begin), text.size());
+            char role = end - begin == 1 ? static_cast<char>(toupper(static_cast<unsigned char>(text[begin]))) : 0;
+            if (role != 'F' && role != 'S') return false;
+            sliding.push_back(role == 'S');
+            begin = end + 1;
+        }
+        return sliding.size() >= 2 && sliding.size() <= kMaxSegments;
+    }
+
+    // Shortest digits that read back as the same float.
+    static string formatSegments(const vector<float>& widths, const vector<char>& sliding) {
+        string text;
+        char digits[32];
+        for (size_t i = 0; i < widths.size(); ++i) {
+            if (i) text += ',';
+            text += sliding[i] ? 'S' : 'F';
+            text.append(digits, to_chars(digits, digits + sizeof digits, widths[i]).ptr);
+        }
+        return text;
+    }
+
+    void inputDimensions() override {
+        cout << "\n--- Bay / Multi-segment Corner Window ---\n";
+        int count;
+        cout << "Number of segments (2 to " << kMaxSegments << "): ";
+        while (!(cin >> count) || count < 2 || count > kMaxSegments) {
+            cin.clear(); cin.ignore(1000, '\n');
+            cout << "❌ Invalid input. Enter 2 to " << kMaxSegments << " segments: ";
+        }
+
+        cout << "Does this window have a coller? (1 = Yes, 0 = No): ";
+        cin >> coller;
+
+        do {
+            cout << "Enter Height " << kSizeUnits << ": ";
+            cin >> asSize(height, "h");
+        } while (rejected(cin) || height <= 0);
+
+        widths.assign(count, 0);
+        sliding.assign(count, 0);
+        for (int i = 0; i < count; ++i) {
+            do {
+                cout << "Enter Width of segment " << (i + 1) << " " << kSizeUnits << ": ";
+                cin >> asSize(widths[i], "segment");
+            } while (rejected(cin) || widths[i] <= 0);
+
+            char role;
+            cout << "Segment " << (i + 1) << " role (F = fixed, S = sliding): ";
+            cin >> role;
+            sliding[i] = (role == 's' || role == 'S');
+        }
+
+        includeTee = false;
+        if (slidingCount() == 0) {
+            cout << "Do you want to add a Tee/Divider? (1 = Yes, 0 = No): ";
+            cin >> includeTee;
+            if (includeTee) {
+                do {
+                    cout << "Enter Tee size " << kSizeUnits << ": ";
+                    cin >> asInches(T);
+                } while (rejected(cin) || T <= 0);
+            }
+        }
+        invalidateSections();
+    }
+
+    // Without segments (older files), width and widthRight make a fixed pair.
+    void loadSpec(const WindowSpec& spec) override {
+        coller = spec.hasColler;
+        height = spec.height;
+        includeTee = spec.includeTee;
+        T = spec.tee;
+        if (spec.segments.empty() || !parseSegments(spec.segments, widths, sliding)) {
+            widths = { spec.width };
+            sliding = { 0 };
+            if (spec.widthRight > 0) {
+                widths.push_back(spec.widthRight);
+                sliding.push_back(0);
+            }
+        }
+        invalidateSections();
+    }
+
+    WindowSpec getSpec() const override {
+        WindowSpec spec;
+        spec.hasColler = coller;
+        spec.height = height;
+        spec.width = totalWidth();
+        spec.includeTee = includeTee;
+        spec.tee = T;
+        spec.segments = formatSegments(widths, sliding);
+        return spec;
+    }
+
+    void displayType() const override {
+        Report& out = Report::out();
+        out << "Bay Window - " << widths.size() << " segments (";
+        for (size_t i = 0; i < sliding.size(); ++i) out << (i ? " " : "") << (sliding[i] ? 'S' : 'F');
+        out << ")\n";
+        out.done();
+    }
+
+    float getArea() const override {
+        return (height / 12.0f) * (totalWidth() / 12.0f);
+    }
+
+    int cornerJoints() const override {
+        return 4 + 2 * (static_cast<int>(widths.size()) - 1);  // each shared post adds two
+    }
+
+    bool drivesWidth() const override { return false; }  // widths come from the segments
+
+    map<string, float> getRequiredSections() const override {
+        map<string, float> sections;
+        float w = totalWidth();
+        int slides = slidingCount();
+
+        if (slides == 0) {  // fix corner profiles
+            if (coller)
+                sections["D54F"] = (height * 2) + (w * 2) + 18;
+            else
+                sections["D54A"] = (height * 2) + (w * 2);
+
+            if (includeTee) {
+                sections["D40"] = T;
+                sections["D41"] = (height * 2) + (w * 2) + (T * 2);
+            } else {
+                sections["D41"] = (height * 2) + (w * 2);
+            }
+            return sections;
+        }
+
+        // Slide corner profiles: a fixed segment anywhere doubles the frame
+        // runs, as on the side-fix corner subtypes.
+        string suffix = coller ? "F" : "A";
+        bool anyFixed = slides < static_cast<int>(widths.size());
+        float netRun = 0;
+        for (size_t i = 0; i < widths.size(); ++i)
+            if (sliding[i]) netRun += (height * 2) + widths[i];
+
+        sections["DC30" + suffix] = (height * 2) + w * (anyFixed ? 2 : 1) + (coller ? 12.0f : 0.0f);
+        sections["DC26" + suffix] = w + (coller ? 6.0f : 0.0f);
+        sections["D29"] = netRun;
+        sections["M23"] = height * 2 * slides;
+        sections["M28"] = height * 2 * slides;
+        sections["M24"] = w * 2;
+        return sections;
+    }
+
+    // One net per sliding segment, half its width.
+    vector<NetPanel> getNetPanels() const override {
+        vector<NetPanel> panels;
+        if (slidingCount() == 0) return panels;
+        for (size_t i = 0; i < widths.size(); ++i)
+            if (sliding[i]) panels.push_back({ height, widths[i] / 2 });
+        return panels;
+    }
+
+    void getHardware(vector<HardwareLine>& kit) const override {
+        FrameComponent::getHardware(kit);
+        float corners = static_cast<float>(widths.size() - 1);
+        int slides = slidingCount();
+        if (slides == 0) {
+            kit.push_back({ "Corner connector", corners });
+            if (includeTee) kit.push_back({ "Tee connector", 2 });
+            return;
+        }
+        float glass = 2.0f * slides;
+        float sashes = glass + slides;  // plus one net each
+        kit.push_back({ "Sliding roller", 2 * sashes });
+        kit.push_back({ "Crescent lock", glass / 2 });
+        kit.push_back({ "Weather brush (ft)", 2 * height * sashes / 12 });
+        kit.push_back({ "Corner connector", corners });
+    }
+
+    void getCutPieces(vector<CutPiece>& out) const override {
+        size_t n = widths.size();
+        int slides = slidingCount();
+
+        if (slides == 0) {
+            string frame = coller ? "D54F" : "D54A";
+            cut(out, frame, 2, height, "H");
+            for (size_t i = 0; i < n; ++i) cut(out, frame, 2, widths[i], label(i));
+            if (coller) { out.back().length += 18; out.back().label += "+18"; }
+
+            cut(out, "D41", 2, height, "H");
+            for (size_t i = 0; i < n; ++i) cut(out, "D41", 2, widths[i], label(i));
+            if (includeTee) {
+                cut(out, "D40", 1, T, "T");
+                cut(out, "D41", 2, T, "T");
+            }
+            return;
+        }
+
+        string suffix = coller ? "F" : "A";
+        int runs = slides < static_cast<int>(n) ? 2 : 1;
+        cut(out, "DC30" + suffix, 2, height, "H");
+        for (size_t i = 0; i < n; ++i) cut(out, "DC30" + suffix, runs, widths[i], label(i));
+        if (coller) { out.back().length += 12; out.back().label += "+12"; }
+        for (size_t i = 0; i < n; ++i) cut(out, "DC26" + suffix, 1, widths[i], label(i));
+        if (coller) { out.back().length += 6; out.back().label += "+6"; }
+
+        for (size_t i = 0; i < n; ++i) {
+            if (!sliding[i]) continue;
+            cut(out, "D29", 2, height, "H");
+            cut(out, "D29", 2, widths[i] / 2, label(i) + "/2");
+        }
+
+        cut(out, "M23", 2 * slides, height, "H");
+        cut(out, "M28", 2 * slides, height, "H");
+        for (size_t i = 0; i < n; ++i) cut(out, "M24", 2, widths[i], label(i));
+    }
+
+    float calculateTotalPrice(const map<string, float>& rates) const override {
+        const auto& sections = requiredSections();
+        float total = 0;
+
+        for (const auto& s : sections) {
+            float inches = s.second;
+            float roundedFeet = roundToMarketFeet(inches);
+            float rate;
+            if (!findRate(rates, s.first, rate)) continue;
+            float price = roundedFeet * rate;
+            total += price;
+
+            printSectionLine(s.first, inches, roundedFeet, price);
+        }
+
+        Report::out().done();
+        return total;
+    }
+
+    // Same market rule as the corner windows.
+    float roundToMarketFeet(float inches) const override {
+        float ft = inches / 12.0f;
+        int whole = static_cast<int>(floor(ft));
+        float inch = (ft - whole) * 12;
+        return (inch <= 6.0f) ? (whole + 0.6f) : (whole + 1.0f);
+    }
+};
+
+/////////////////////////////////////////////////////////
+// ♻️ Offcut Inventory (leftover lengths per section code)
+/////////////////////////////////////////////////////////
+
+class OffcutInventory {
+    map<string, multiset<float>> racks;  // section code -> sorted offcut lengths (inches)
+    string path;
+
+public:
+    static constexpr float kSawKerf = 0.125f;        // lost per cut (inches)
+    static constexpr float kMinUsableLength = 12.0f;  // shorter remnants are scrap
+
+    explicit OffcutInventory(string file = "offcuts.txt") : path(move(file)) {
+        load();
+    }
+
+    bool load() {
+        string text;
+        if (!SessionJournal::get().readFile(path, text)) return false;
+        istringstream in(text);
+
+        racks.clear();
+        string code;
+        float inches;
+        while (in >> code >> inches) add(code, inches);  // same scrap rule as new offcuts
+        return true;
+    }
+
+    bool save() const {
+        if (SessionJournal::get().replaying()) return true;
+        ofstream out(path);
+        if (!out) {
+            cerr << "❌ Error: Could not write offcut inventory to " << path << "\n";
+            return false;
+        }
+
+        out << fixed << setprecision(3);
+        for (const auto& rack : racks)
+            for (float inches : rack.second)
+                out << rack.first << " " << inches << "\n";
+        return true;
+    }
+
+    void add(const string& code, float inches) {
+        if (inches >= kMinUsableLength) racks[code].insert(inches);
+    }
+
+    bool remove(const string& code, float inches) {
+        auto rack = racks.find(code);
+        if (rack == racks.end()) return false;
+
+        auto it = rack->second.find(inches);
+        if (it == rack->second.end()) return false;
+
+        rack->second.erase(it);
+        if (rack->second.empty()) racks.erase(rack);
+        return true;
+    }
+
+    // Best fit: the shortest offcut that still covers the cut. The remnant
+    // (minus kerf) goes back on the rack if it is still usable.
+    bool take(const string& code, float needed, float& offcutUsed) {
+        auto rack = racks.find(code);
+        if (rack == racks.end()) return false;
+
+        auto it = rack->second.lower_bound(needed);
+        if (it == rack->second.end()) return false;
+
+        offcutUsed = *it;
+        rack->second.erase(it);
+
+        float remnant = offcutUsed - needed - kSawKerf;
+        if (remnant >= kMinUsableLength) rack->second.insert(remnant);
+        if (rack->second.empty()) racks.erase(rack);
+        return true;
+    }
+
+    // Undoes take(): the offcut goes back and its remnant comes off. False,
+    // with nothing changed, when a later take has already cut the remnant.
+    bool putBack(const string& code, float needed, float offcutUsed) {
+        float remnant = offcutUsed - needed - kSawKerf;
+        if (remnant >= kMinUsableLength && !remove(code, remnant)) return false;
+        racks[code].insert(offcutUsed);
+        return true;
+    }
+
+    size_t count() const {
+        size_t n = 0;
+        for (const auto& rack : racks) n += rack.second.size();
+        return n;
+    }
+
+    bool empty() const { return racks.empty(); }
+
+    void display() const {
+        if (racks.empty()) {
+            cout << "⚠️ Offcut inventory is empty.\n";
+            return;
+        }
+
+        cout << fixed << setprecision(2);
+        for (const auto& rack : racks) {
+            float total = 0;
+            for (float inches : rack.second) total += inches;
+            cout << rack.first << ": " << rack.second.size() << " piece(s), "
+                 << total << " inches total (longest " << *rack.second.rbegin() << " in)\n";
+        }
+    }
+
+    // Cut the batch's individual pieces (getCutPieces) from the racks,
+    // longest first, best fit each. A section is then bought only for the
+    // pieces left over, so the saving is the market-rounded cost of the
+    // whole section minus that of the remainder. A take that does not lower
+    // the market-rounded length goes back on the rack, shortest first.
+    // Returns the saving (Rs.).
+    float applyToBatch(const vector<unique_ptr<FrameComponent>>& batch,
+                       const map<string, float>& rates) {
+        struct Take {
+            const CutPiece* piece;
+            float offcut;
+        };
+
+        float savedInches = 0, savedRs = 0;
+        int used = 0;
+        vector<CutPiece> pieces;
+
+        cout << fixed << setprecision(2);
+        for (const auto& win : batch) {
+            pieces.clear();
+            win->getCutPieces(pieces);
+            sort(pieces.begin(), pieces.end(), [](const CutPiece& a, const CutPiece& b) {
+                return a.length > b.length;
+            });
+
+            map<string, vector<Take>> fromRack;  // section -> pieces cut from offcuts, in order
+            for (const CutPiece& piece : pieces) {
+                if (piece.length <= 0 || !rates.count(piece.profile)) continue;
+
+                float offcut;
+                if (take(piece.profile, piece.length, offcut)) fromRack[piece.profile].push_back({ &piece, offcut });
+            }
+
+            const SectionList& sections = win->requiredSections();
+            for (auto& r : fromRack) {
+                vector<Take>& takes = r.second;
+                auto section = sections.find(r.first);
+                float whole = section == sections.end() ? 0 : section->second;
+                auto bought = [&](float cut) {
+                    float remaining = whole - cut;
+                    return remaining > 0.01f ? win->roundToMarketFeet(remaining) : 0;
+                };
+
+                float cut = 0;
+                for (const Take& t : takes) cut += t.piece->length;
+                for (size_t i = takes.size(); i-- > 0;) {
+                    float without = cut - takes[i].piece->length;
+                    if ((section == sections.end() || bought(without) == bought(cut)) &&
+                        putBack(r.first, takes[i].piece->length, takes[i].offcut)) {
+                        cut = without;
+                        takes.erase(takes.begin() + i);
+                    }
+                }
+                if (takes.empty()) continue;
+
+                for (const Take& t : takes)
+                    cout << "♻️ " << r.first << " (" << t.piece->label << "): " << t.piece->length
+                         << " inches cut from " << t.offcut << " in offcut\n";
+                float saved = (win->roundToMarketFeet(whole) - bought(cut)) * rates.at(r.first);
+                used += static_cast<int>(takes.size());
+                savedInches += cut;
+                savedRs += saved;
+                cout << "♻️ " << r.first << ": buy " << whole - cut << " of " << whole
+                     << " inches => saved Rs. " << saved << "\n";
+            }
+        }
+
+        if (used == 0) {
+            cout << "⚠️ No offcuts that would save anything on this batch.\n";
+        } else {
+            cout << "♻️ Offcuts used: " << used << ", material saved: " << savedInches
+                 << " inches (" << savedInches / 12.0f << " ft), Rs. " << savedRs << "\n";
+            save();
+        }
+
+        return savedRs;
+    }
+};
+
+/////////////////////////////////////////////////////////
+// 🏷️ Supplier Price Lists (rates indexed by dense section ID)
+/////////////////////////////////////////////////////////
+
+// Each CSV in the price list folder is one supplier, named after the file:
+//     section,rate
+//     D54F,145
+// An optional third column names the supplier, so one file can hold several.
+class PriceBook {
+public:
+    enum class Policy { Cheapest, Preferred };
+
+private:
+    vector<int> listed;                     // SectionCodes IDs some supplier lists, in load order
+    vector<string> suppliers;
+    vector<vector<float>> supplierRates;    // [supplier][section ID], NaN = not listed
+    vector<float> resolvedRate;             // [section ID], NaN = nobody lists it
+    vector<int> resolvedSupplier;           // [section ID]
+    Policy policy = Policy::Cheapest;
+    int preferred = -1;
+
+    int internSection(const string& code) {
+        int id = SectionCodes::id(code);
+        if (id < 0) return -1;
+        for (auto& list : supplierRates)
+            if (id >= static_cast<int>(list.size())) list.resize(id + 1, NAN);
+        if (find(listed.begin(), listed.end(), id) == listed.end()) listed.push_back(id);
+        return id;
+    }
+
+    int internSupplier(const string& name) {
+        for (size_t i = 0; i < suppliers.size(); ++i)
+            if (suppliers[i] == name) return static_cast<int>(i);
+
+        suppliers.push_back(name);
+        supplierRates.emplace_back(SectionCodes::count(), NAN);
+        return static_cast<int>(suppliers.size()) - 1;
+    }
+
+    float supplierRate(size_t sup, int id) const {
+        return id < static_cast<int>(supplierRates[sup].size()) ? supplierRates[sup][id] : NAN;
+    }
+
+    // Pick one rate per section up front so pricing never compares suppliers.
+    void resolve() {
+        resolvedRate.assign(SectionCodes::count(), NAN);
+        resolvedSupplier.assign(SectionCodes::count(), -1);
+
+        for (int id : listed) {
+            if (policy == Policy::Preferred && preferred >= 0 && !isnan(supplierRate(preferred, id))) {
+                resolvedRate[id] = supplierRate(preferred, id);
+                resolvedSupplier[id] = preferred;
+                continue;
+            }
+
+            for (size_t sup = 0; sup < suppliers.size(); ++sup) {
+                float r = supplierRate(sup, id);
+                if (!isnan(r) && (isnan(resolvedRate[id]) || r < resolvedRate[id])) {
+                    resolvedRate[id] = r;
+                    resolvedSupplier[id] = static_cast<int>(sup);
+                }
+            }
+        }
+    }
+
+    static string trim(const string& text) {
+        size_t first = text.find_first_not_of(" \t\r");
+        if (first == string::npos) return "";
+        return text.substr(first, text.find_last_not_of(" \t\r") - first + 1);
+    }
+
+public:
+    bool loadCsv(const string& path, const string& supplier) {
+        ifstream in(path);
+        if (!in) return false;
+
+        string line;
+        int lineNo = 0;
+        while (getline(in, line)) {
+            ++lineNo;
+            if (line.empty() || line[0] == '#') continue;
+
+            string code, rateText, name;
+            istringstream fields(line);
+            getline(fields, code, ',');
+            getline(fields, rateText, ',');
+            getline(fields, name);
+            code = trim(code);
+            rateText = trim(rateText);
+            name = trim(name);  // CRLF files leave '\r' on the last column
+
+            char* end = nullptr;
+            float rate = strtof(rateText.c_str(), &end);
+            if (code.empty() || end == rateText.c_str() || rate < 0) {
+                if (lineNo > 1)  // first line may be a header
+                    cerr << "⚠️ Skipping line " << lineNo << " of " << path << ": " << line << "\n";
+                continue;
+            }
+
+            int sup = internSupplier(name.empty() ? supplier : name);
+            int id = internSection(code);
+            if (id >= 0) supplierRates[sup][id] = rate;
+        }
+
+        resolve();
+        return true;
+    }
+
+    size_t loadFolder(const string& dir = "pricelists") {
+        size_t loaded = 0;
+        error_code ec;
+        for (const auto& file : filesystem::directory_iterator(dir, ec)) {
+            if (file.path().extension() == ".csv" && loadCsv(file.path().string(), file.path().stem().string()))
+                ++loaded;
+        }
+        return loaded;
+    }
+
+    // Reads the folder again from scratch. A preferred supplier stays
+    // preferred while it is still listed.
+    size_t reload(const string& dir = "pricelists") {
+        string keep = policy == Policy::Preferred && preferred >= 0 ? suppliers[preferred] : "";
+        *this = PriceBook();
+        size_t loaded = loadFolder(dir);
+        if (!keep.empty() && !usePreferred(keep))
+            cout << "⚠️ Preferred supplier " << keep << " is no longer listed; using the cheapest.\n";
+        return loaded;
+    }
+
+    void useCheapest() {
+        policy = Policy::Cheapest;
+        resolve();
+    }
+
+    bool usePreferred(const string& supplier) {
+        for (size_t i = 0; i < suppliers.size(); ++i) {
+            if (suppliers[i] != supplier) continue;
+            policy = Policy::Preferred;
+            preferred = static_cast<int>(i);
+            resolve();
+            return true;
+        }
+        return false;
+    }
+
+    // Array index by SectionCodes ID (e.g. SectionList::Entry::id); NaN
+    // when no supplier lists the section. lookup() by code first finds the
+    // ID with SectionCodes::find, a linear scan of the code table.
+    float rate(int id) const {
+        return (id >= 0 && id < static_cast<int>(resolvedRate.size())) ? resolvedRate[id] : NAN;
+    }
+
+    bool lookup(const string& code, float& rateOut, string* supplier = nullptr) const {
+        int sectionId = SectionCodes::find(code);
+        float r = rate(sectionId);
+        if (isnan(r)) return false;
+
+        rateOut = r;
+        if (supplier) *supplier = suppliers[resolvedSupplier[sectionId]];
+        return true;
+    }
+
+    bool empty() const { return listed.empty(); }
+    size_t supplierCount() const { return suppliers.size(); }
+    size_t sectionCount() const { return listed.size(); }
+
+    void display() const {
+        if (empty()) {
+            cout << "⚠️ No price lists loaded (put supplier CSV files in pricelists/).\n";
+            return;
+        }
+
+        cout << fixed << setprecision(2);
+        cout << "Policy: " << (policy == Policy::Cheapest ? "cheapest supplier" : "preferred supplier " + suppliers[preferred])
+             << "\n";
+        cout << left << setw(10) << "Section";
+        for (const auto& sup : suppliers) cout << setw(14) << sup.substr(0, 13);
+        cout << "Chosen\n";
+
+        for (int id : listed) {
+            cout << left << setw(10) << SectionCodes::name(id);
+            for (size_t sup = 0; sup < suppliers.size(); ++sup) {
+                if (isnan(supplierRate(sup, id))) cout << setw(14) << "-";
+                else cout << setw(14) << supplierRate(sup, id);
+            }
+            cout << suppliers[resolvedSupplier[id]] << "\n";
+        }
+        cout << right;
+    }
+};
+
+// Rates for a set of sections: from the price lists where listed,
+// otherwise asked for once each. A replayed session uses the rates it
+// recorded (or the replay's rate file) instead of today's price lists.
+map<string, float> collectRates(const set<string>& neededSections, const PriceBook& priceBook) {
+    map<string, float> rates;
+    SessionJournal& journal = SessionJournal::get();
+    journal.beginRateBatch();
+
+    for (const auto& secName : neededSections) {
+        float rate;
+        string supplier;
+        if (journal.replayRate(secName, rate)) {
+            rates[secName] = rate;
+            continue;
+        }
+        if (priceBook.lookup(secName, rate, &supplier)) {
+            cout << fixed << setprecision(2) << "Rate for " << secName << ": Rs. " << rate
+                 << "/ft (" << supplier << ")\n";
+            rates[secName] = rate;
+            journal.recordRate(secName, rate, supplier);
+            continue;
+        }
+
+        cout << "Enter rate for " << secName << " (Rs./ft): ";
+        while (!(cin >> rate) || rate < 0) {
+            cout << "Invalid rate. Enter again: ";
+            cin.clear(); cin.ignore(10000, '\n');
+        }
+        rates[secName] = rate;
+        journal.recordRate(secName, rate, "typed");
+    }
+
+    return rates;
+}
+
+/////////////////////////////////////////////////////////
+// 🗃️ Quote Result Cache (spec + section rates -> line items, on disk)
+/////////////////////////////////////////////////////////
+
+class QuoteCache {
+public:
+    struct LineItem {
+        string section;
+        float inches, roundedFeet, price;
+    };
+
+    struct Quote {
+        float total = 0;
+        vector<LineItem> lines;
+    };
+
+private:
+    struct Entry {
+        string text;  // full key, see keyText(); a hash match alone is not enough
+        Quote quote;
+    };
+    list<Entry> lru;  // most recently used first
+    unordered_map<uint64_t, list<Entry>::iterator> index;  // fnv1a(text)
+    string path;
+    size_t capacity;
+    long long hits = 0, misses = 0;
+    bool dirty = false;
+
+    static uint64_t fnv1a(const string& text, uint64_t h = 1469598103934665603ULL) {
+        for (unsigned char c : text) {
+            h ^= c;
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+public:
+    explicit QuoteCache(string file = "quote_cache.db", size_t maxEntries = 10000)
+        : path(move(file)), capacity(maxEntries) {
+        load();
+    }
+
+    // The normalised spec plus each section the window uses, with its
+    // length and rate ("-" when none was entered): a rate change elsewhere
+    // in the batch leaves the entry valid, and a build whose formulas give
+    // other lengths does not reuse quotes saved by an older one.
+    static string keyText(const WindowSpec& spec, const FrameComponent& win, const RateTable& rates) {
+        ostringstream text;
+        text << setprecision(9) << formatSpec(spec) << " |";
+        for (const auto& s : win.requiredSections()) {
+            float rate = rates.rate(s.id);
+            text << ' ' << s.first << ':' << s.second << '=';
+            if (isnan(rate)) text << '-';
+            else text << rate;
+        }
+        return text.str();
+    }
+
+    // What calculateTotalPrice would print and return, without printing.
+    static Quote quote(const FrameComponent& win, const RateTable& rates) {
+        Quote q;
+        for (const auto& s : win.requiredSections()) {
+            float cost;
+            if (!win.sectionCost(s.id, s.second, rates, cost)) continue;
+            q.lines.push_back({ s.first, s.second, win.roundToMarketFeet(s.second), cost });
+            q.total += cost;
+        }
+        return q;
+    }
+
+    bool get(const string& text, Quote& out) {
+        auto it = index.find(fnv1a(text));
+        if (it == index.end() || it->second->text != text) {
+            ++misses;
+            return false;
+        }
+
+        lru.splice(lru.begin(), lru, it->second);
+        out = it->second->quote;
+        ++hits;  // the new recency order is saved with the next put()
+        return true;
+    }
+
+    // A different key with the same hash is replaced.
+    void put(const string& text, Quote q) {
+        uint64_t k = fnv1a(text);
+        auto it = index.find(k);
+        if (it != index.end()) {
+            it->second->text = text;
+            it->second->quote = move(q);
+            lru.splice(lru.begin(), lru, it->second);
+        } else {
+            lru.push_front({ text, move(q) });
+            index[k] = lru.begin();
+            while (lru.size() > capacity) {
+                index.erase(fnv1a(lru.back().text));
+                lru.pop_back();
+            }
+        }
+        dirty = true;
+    }
+
+    // One entry per line, most recent first, the key text between tabs:
+    //     key<TAB>total count section inches roundedFeet price ...
+    // Lines in the older hash-only format are dropped.
+    // A replay starts empty instead: the file may have changed since the
+    // session was recorded, and the replay must not depend on it.
+    bool load() {
+        if (SessionJournal::get().replaying()) return false;
+        ifstream in(path);
+        if (!in) return false;
+
+        string line;
+        while (getline(in, line) && lru.size() < capacity) {
+            size_t tab = line.find('\t');
+            if (tab == string::npos) continue;
+
+            Entry e{ line.substr(0, tab), {} };
+            istringstream fields(line.substr(tab + 1));
+            size_t count;
+            if (!(fields >> e.quote.total >> count)) continue;
+
+            for (size_t i = 0; i < count; ++i) {
+                LineItem item;
+                if (!(fields >> item.section >> item.inches >> item.roundedFeet >> item.price)) break;
+                e.quote.lines.push_back(item);
+            }
+            uint64_t k = fnv1a(e.text);
+            if (e.quote.lines.size() != count || index.count(k)) continue;
+
+            lru.push_back(move(e));
+            index[k] = prev(lru.end());
+        }
+        return true;
+    }
+
+    bool save() {
+        if (!dirty || SessionJournal::get().replaying()) return true;
+
+        ofstream out(path);
+        if (!out) {
+            cerr << "❌ Error: Could not write quote cache to " << path << "\n";
+            return false;
+        }
+
+        out << setprecision(9);
+        for (const auto& e : lru) {
+            out << e.text << '\t' << e.quote.total << ' ' << e.quote.lines.size();
+            for (const auto& item : e.quote.lines)
+                out << ' ' << item.section << ' ' << item.inches << ' ' << item.roundedFeet << ' ' << item.price;
+            out << '\n';
+        }
+        dirty = false;
+        return true;
+    }
+
+    void printStats() const {
+        long long lookups = hits + misses;
+        cout << fixed << setprecision(1) << "🗃️ Quote cache: " << hits << " hit(s), " << misses << " miss(es)";
+        if (lookups) cout << " (" << 100.0 * hits / lookups << "% hit rate)";
+        cout << ", " << lru.size() << "/" << capacity << " entries\n" << setprecision(2);
+    }
 };
+
 /////////////////////////////////////////////////////////
-// 🪟 Three and Two (M section ) Panel Window Class (Type 1 and 2)
+// ⚡ Background Pricing While the Next Window Is Typed
 /////////////////////////////////////////////////////////
 
-class FlexiblePanelWindow : public FrameComponent {
-    float height = 0, width = 0;
-    int collerType = 1;
-    bool includeD29 = true;
-    bool useMSeriesSections = false;
+// Windows are handed over as soon as their dimensions are complete. A worker
+// thread computes their sections, gathers the rates the batch needs and, when
+// every rate is already in the price lists, prices the window straight away,
+// so the running total is final when the last dimension is entered and only
+// windows that waited for a typed rate are priced after finish().
+class AsyncBatchPricer {
+    struct Priced {
+        FrameComponent* window = nullptr;
+        QuoteCache::Quote quote;  // at price-list rates
+        bool complete = false;    // every section was listed
+    };
 
-public:
-    // Constructor lets you control behavior for any type
-    FlexiblePanelWindow(bool includeD29 = true, bool useMSeries = false)
-        : includeD29(includeD29), useMSeriesSections(useMSeries) {}
+    const PriceBook& priceBook;
+    queue<size_t> pending;
+    deque<Priced> results;  // by submit order; deque so workers' entries never move
+    set<string> neededSections;
+    float runningTotal = 0;
+    int submitted = 0, priced = 0;
+    bool closed = false;
+
+    mutable mutex lock;
+    condition_variable wake;
+    thread worker;
+
+    void run() {
+        while (true) {
+            Priced* job;
+            {
+                unique_lock<mutex> guard(lock);
+                wake.wait(guard, [this] { return closed || !pending.empty(); });
+                if (pending.empty()) return;
+                job = &results[pending.front()];
+                pending.pop();
+            }
 
-    void inputDimensions() override {
-        cout << "Enter Collar Type (1 to 14): ";
-        while (!(cin >> collerType) || collerType < 1 || collerType > 14) {
-            cin.clear(); cin.ignore(1000, '\n');
-            cout << "❌ Invalid input. Please enter collar type (1 to 14): ";
+            // Heavy part outside the lock: section map and price-list lookups.
+            const FrameComponent& win = *job->window;
+            const SectionList& sections = win.requiredSections();
+            QuoteCache::Quote q;
+            bool complete = true;
+            for (const auto& s : sections) {
+                float rate = priceBook.rate(s.id);
+                if (isnan(rate)) {
+                    complete = false;
+                    break;
+                }
+                float feet = win.roundToMarketFeet(s.second);
+                q.lines.push_back({ s.first, s.second, feet, feet * rate });
+                q.total += feet * rate;
+            }
+
+            lock_guard<mutex> guard(lock);
+            for (const auto& s : sections) neededSections.insert(s.first);
+            if (complete) {
+                job->quote = move(q);
+                job->complete = true;
+                runningTotal += job->quote.total;
+                ++priced;
+            }
         }
+    }
 
-        cout << "Enter height (in inches): ";
-        while (!(cin >> height) || height <= 0) {
-            cin.clear(); cin.ignore(1000, '\n');
-            cout << "❌ Invalid input. Enter height again (in inches): ";
+public:
+    explicit AsyncBatchPricer(const PriceBook& book) : priceBook(book), worker([this] { run(); }) {}
+
+    ~AsyncBatchPricer() { finish(); }
+
+    // The window must not be modified until finish() returns.
+    void submit(FrameComponent* win) {
+        {
+            lock_guard<mutex> guard(lock);
+            results.emplace_back();
+            results.back().window = win;
+            pending.push(results.size() - 1);
+            ++submitted;
         }
+        wake.notify_one();
+    }
 
-        cout << "Enter width (in inches): ";
-        while (!(cin >> width) || width <= 0) {
-            cin.clear(); cin.ignore(1000, '\n');
-            cout << "❌ Invalid input. Enter width again (in inches): ";
+    void printProgress() const {
+        lock_guard<mutex> guard(lock);
+        if (priced == 0) return;
+        cout << fixed << setprecision(2) << "⚡ Running aluminium total: Rs. " << runningTotal << " ("
+             << priced << " of " << submitted << " window(s) priced from price lists)\n";
+    }
+
+    // After finish(): the worker's quote for the i-th submitted window, if
+    // it priced that window at the batch's final rates (a replayed session
+    // may use other rates than today's price lists).
+    bool result(size_t i, const RateTable& rates, QuoteCache::Quote& out) const {
+        const Priced& p = results[i];
+        if (!p.complete) return false;
+        for (const auto& s : p.window->requiredSections())
+            if (rates.rate(s.id) != priceBook.rate(s.id)) return false;
+        out = p.quote;
+        return true;
+    }
+
+    // Waits for the worker and returns every section the batch needs.
+    set<string> finish() {
+        {
+            lock_guard<mutex> guard(lock);
+            closed = true;
         }
+        wake.notify_one();
+        if (worker.joinable()) worker.join();
+        return neededSections;
     }
+};
 
-    void displayType() const override {
-        cout << (includeD29 ? "Three Panel Window\n" : "Two Panel Window\n");
+/////////////////////////////////////////////////////////
+// 🧠 Final Cost Summary Class
+/////////////////////////////////////////////////////////
+
+struct CostRates {
+    string name = "entered";
+    float glassRate = 0, laborRate = 0, hardwareRate = 0, discountPercent = 0;
+};
+
+class FinalCostCalculator {
+public:
+    static CostRates promptRates() {
+        CostRates r;
+
+        cout << "\nEnter glass rate (Rs./sqft): ";
+        cin >> r.glassRate;
+        cout << "Enter labor rate (Rs./sqft): ";
+        cin >> r.laborRate;
+        cout << "Enter hardware cost per window: ";
+        cin >> r.hardwareRate;
+        cout << "Enter discount (%): ";
+        cin >> r.discountPercent;
+
+        return r;
     }
 
-    float getArea() const override {
-        return (height / 12.0f) * (width / 12.0f);
+    // One rate set per line: name glass labor hardware discount%
+    // Lines starting with '#' are comments.
+    static vector<CostRates> loadRates(const string& path = "cost_rates.cfg") {
+        vector<CostRates> sets;
+        string text;
+        SessionJournal::get().readFile(path, text);
+        istringstream in(text);
+        string line;
+
+        while (getline(in, line)) {
+            if (line.empty() || line[0] == '#') continue;
+
+            istringstream fields(line);
+            CostRates r;
+            if (fields >> r.name >> r.glassRate >> r.laborRate >> r.hardwareRate >> r.discountPercent)
+                sets.push_back(r);
+            else
+                cerr << "⚠️ Skipping malformed rate line in " << path << ": " << line << "\n";
+        }
+
+        return sets;
     }
 
-    map<string, float> getRequiredSections() const override {
-        map<string, float> sections;
-        float h = height, w = width;
+    static void calculate(float aluminiumTotal, float totalSqFt, int windowCount) {
+        calculate(aluminiumTotal, totalSqFt, windowCount, promptRates());
+    }
+
+    // kitHardware: priced hardware kits for the whole project; negative
+    // means no kit prices, charge the flat rate per window.
+    static void calculate(float aluminiumTotal, float totalSqFt, int windowCount, const CostRates& r,
+                          float kitHardware = -1) {
+        float glass = r.glassRate * totalSqFt;
+        float labor = r.laborRate * totalSqFt;
+        float hardware = kitHardware >= 0 ? kitHardware : r.hardwareRate * windowCount;
 
-        // Helper function to get correct section name
-       auto sec = [&](const string& base) -> string {
-        if (useMSeriesSections) {
-        if (base == "DC30F") return "M30F";
-        if (base == "DC26F") return "M26F";
-        if (base == "DC30C") return "M30";
-        if (base == "DC26C") return "M26";
+        float discount = (r.discountPercent / 100.0f) * aluminiumTotal;
+        float discountedAluminium = aluminiumTotal - discount;
+        float net = discountedAluminium + glass + labor + hardware;
+
+        Report& out = Report::out();
+        out << "\n--- Final Summary";
+        if (r.name != "entered") out << " (" << r.name << ")";
+        out << " ---\n";
+        out << "Aluminium (before discount): Rs. " << aluminiumTotal << "\n";
+        out << "Discount on Aluminium (" << r.discountPercent << "%): Rs. " << discount << "\n";
+        out << "Aluminium (after discount): Rs. " << discountedAluminium << "\n";
+        out << "Glass: Rs. " << glass << "\n";
+        out << "Labor: Rs. " << labor << "\n";
+        out << "Hardware" << (kitHardware >= 0 ? " (kits)" : "") << ": Rs. " << hardware << "\n";
+        out << "Net Total: Rs. " << net << "\n";
+        out.done();
+
+        SessionJournal::get().result("net total (" + r.name + ")", net);
     }
-    return base;  // always return std::string
-    };
+};
 
+/////////////////////////////////////////////////////////
+// 🏗️ Window Type Registry (factories + metadata, add new types here)
+/////////////////////////////////////////////////////////
 
-        // Collar logic
-        switch (collerType) {
-            case 1:  sections[sec("DC30F")] = (h * 2) + w + 9; sections[sec("DC26F")] = w + 3;                                       break;
-            case 2:  sections[sec("DC30C")] = (h * 2) + w;     sections[sec("DC26C")] = w;                                           break;
-            case 3:  sections[sec("DC30C")] = w;               sections[sec("DC30F")] = (h * 2) + 6; sections[sec("DC26F")] = w + 3; break;
-            case 4:  sections[sec("DC30C")] = h;               sections[sec("DC30F")] = (h + w) + 6; sections[sec("DC26F")] = w + 3; break;
-            case 5:  sections[sec("DC30F")] = (h * 2) + w + 9; sections[sec("DC26C")] = w;                                           break;
-            case 6:  sections[sec("DC30C")] = h;               sections[sec("DC30F")] = (h + w) + 6; sections[sec("DC26F")] = w + 3; break;
-            case 7:  sections[sec("DC30C")] = h + w;           sections[sec("DC30F")] = h + 3;       sections[sec("DC26F")] = w + 3; break;
-            case 8:  sections[sec("DC30C")] = h;               sections[sec("DC30F")] = (h + w) + 6; sections[sec("DC26C")] = w;     break;
-            case 9:  sections[sec("DC30C")] = h * 2;           sections[sec("DC30F")] = w + 3;       sections[sec("DC26F")] = w + 3; break;
-            case 10: sections[sec("DC30C")] = w;               sections[sec("DC30F")] = (h * 2) + 6; sections[sec("DC26C")] = w;     break;
-            case 11: sections[sec("DC30C")] = h * 2;           sections[sec("DC30F")] = w + 3;       sections[sec("DC26C")] = w;     break;
-            case 12: sections[sec("DC30C")] = w + h;           sections[sec("DC30F")] = h + 3;       sections[sec("DC26C")] = w;     break;
-            case 13: sections[sec("DC30C")] = (h * 2) + w;     sections[sec("DC26F")] = w + 3;                                       break;
-            case 14: sections[sec("DC30C")] = h + w;           sections[sec("DC30F")] = h + 3;       sections[sec("DC26F")] = w;     break;
-            default: break; // Safe fallback
+enum class Series : uint8_t { DC = 0, M = 1 };
+
+struct WindowTypeInfo {
+    int id = 0;
+    string name;         // short key, e.g. "fixed"; accepted as type= in project files
+    string displayName;  // menu text
+    string inputs;       // project file keys the type uses, in prompt order; drives import checks
+    int collars = 1;     // collar/subtype range 1..collars; 1 means no collar table
+    function<unique_ptr<FrameComponent>()> make;
+    float minInches = 6, maxInches = 240;  // accepted h/w/wr; catches sizes in the wrong unit
+    Series series = Series::DC;
+    function<string(const WindowSpec&)> check = nullptr;  // rules the inputs cannot express; "" = fine
+
+    // Whether key is one of the inputs, as a whole word.
+    bool uses(const char* key) const {
+        size_t n = strlen(key);
+        for (size_t at = inputs.find(key); at != string::npos; at = inputs.find(key, at + 1))
+            if ((at == 0 || inputs[at - 1] == ' ') && (at + n == inputs.size() || inputs[at + n] == ' '))
+                return true;
+        return false;
+    }
+
+    // "" when inches is in range; otherwise why not, suggesting mm or cm
+    // when that would fit.
+    string checkSize(const char* key, float inches) const {
+        if (inches >= minInches && inches <= maxInches) return "";
+        ostringstream msg;
+        msg << key << "=" << inches << " in is outside " << minInches << " to " << maxInches
+            << " in for " << displayName;
+        for (Units::Unit u : { Units::Millimetre, Units::Centimetre }) {
+            float converted = inches * Units::kToInches[u];
+            if (converted >= minInches && converted <= maxInches) {
+                msg << " (meant " << inches << Units::name(u) << "?)";
+                break;
+            }
         }
+        return msg.str();
+    }
+};
 
-        // Common members
-        sections["M23"] = h * 2;
-        sections["M28"] = h * 2;
-        sections["M24"] = w * 2;
+istream& operator>>(istream& in, InchesField field) {
+    string token;
+    if (!(in >> token)) return in;
+
+    // Join the rest of the answer from the same line: a unit ("1200 mm"),
+    // or inches after feet ("5' 3", "5'3 1/2").
+    for (int parts = 0; parts < 4; ++parts) {
+        while (in.peek() == ' ' || in.peek() == '\t') in.get();
+        int next = in.peek();
+        bool unit = isalpha(next) || next == '"' || next == '\'';
+        bool feet = token.find('\'') != string::npos || token.find("ft") != string::npos ||
+                    token.find("feet") != string::npos;
+        bool inchesAfterFeet = isdigit(next) && feet && token.back() != '"';
+        string rest;
+        if (!(unit || inchesAfterFeet) || !(in >> rest)) break;
+        token += ' ' + rest;
+    }
 
-        if (includeD29)
-            sections["D29"] = (h * 2) + w;
+    auto reject = [&](const string& why) {
+        cout << "❌ " << why << "\n";
+        while (in.peek() != '\n' && in.peek() != EOF) in.get();  // the newline ends the answer
+        in.setstate(ios::failbit);
+    };
 
-        return sections;
+    float inches;
+    if (!Units::parse(token, inches)) {
+        reject("Not a size: '" + token + "'. Try 48, 4'6\", 1200mm or 120cm.");
+        return in;
     }
+    string outOfRange = field.key && InchesField::active ? InchesField::active->checkSize(field.key, inches) : "";
+    if (!outOfRange.empty()) reject(outOfRange);
+    else field.value = inches;
+    return in;
+}
 
-    float calculateTotalPrice(const map<string, float>& rates) const override {
-        auto sections = getRequiredSections();
-        float total = 0;
+// Types register at startup, then main() freezes the registry. After that it
+// never changes, so worker threads look types up without taking a lock.
+// Plug-in types register with add() (or a static Registrar) before freeze().
+class ComponentRegistry {
+    struct Storage {
+        vector<WindowTypeInfo> types;  // index = id - 1, ids are contiguous
+        unordered_map<string, int> byName;
+        atomic<bool> frozen{false};
 
-        for (const auto& s : sections) {
-            float inches = s.second;
-            float ft = inches / 12.0f;
-            float rounded = roundToMarketFeet(inches);
+        Storage() { registerBuiltins(*this); }
+    };
 
-            float price = rounded * rates.at(s.first);
-            total += price;
+    static Storage& storage() {
+        static Storage s;
+        return s;
+    }
+
+    static void put(Storage& s, WindowTypeInfo info) {
+        info.id = static_cast<int>(s.types.size()) + 1;
+        s.byName[info.name] = info.id;
+        s.types.push_back(move(info));
+    }
+
+    template <class Window, class... Args>
+    static function<unique_ptr<FrameComponent>()> maker(Args... args) {
+        return [=] { return make_unique<Window>(args...); };
+    }
+
+    static void registerBuiltins(Storage& s) {
+        put(s, { 0, "three-panel", "Three Panel Window", "collar h w", 14,
+                 maker<FlexiblePanelWindow>(true, false) });
+        put(s, { 0, "two-panel-m", "Two Panel Window (M section)", "collar h w", 14,
+                 maker<FlexiblePanelWindow>(false, true), 6, 240, Series::M });
+        put(s, { 0, "three-panel-3glass", "Three Panel Window (3 glass part)", "collar net netwidth h w", 14,
+                 maker<ThreePanel_3glass>(true, string("DC30"), string("DC26")) });  // with D29
+        put(s, { 0, "two-panel-3glass-m", "Two Panel Window (3 glass part & M section)", "collar h w", 14,
+                 maker<ThreePanel_3glass>(false, string("M30"), string("M26")), 6, 240, Series::M });  // without D29
+        put(s, { 0, "fixed", "Fixed Window", "collar tee h w", 14, maker<FixWindow>() });
+        put(s, { 0, "random-fixed", "Random Design Fixed Window", "tee length", 1, maker<RandomFixWindow>(),
+                 6, 2400 });  // length is the total run of profile
+        put(s, { 0, "openable", "openable Window", "collar hasnet h w", 14, maker<OpenableWindow>() });
+        put(s, { 0, "single-door", "Single Door", "collar d46 tee h w", 8, maker<DoorWindow>(false), 18, 144 });
+        put(s, { 0, "double-door", "Double Door", "collar d46 tee h w", 8, maker<DoorWindow>(true), 18, 144 });
+        put(s, { 0, "qadial-arch", "Qadial Top Arch", "collar tee h w rise", 8, maker<QadialArchWindow>(),
+                 6, 240, Series::DC, QadialArchWindow::checkSpec });
+        put(s, { 0, "round-arch", "Round Top Arch", "coller tee shape h w arch rise", 1, maker<RoundArchWindow>(),
+                 6, 240, Series::DC, RoundArchWindow::checkSpec });
+        put(s, { 0, "fix-corner", "Fix corner Window", "coller tee h w wr", 1, maker<FixCornerWindow>() });
+        put(s, { 0, "slide-corner", "Slide Corner Window", "subtype coller netwidth h w wr", 5,
+                 maker<SlideCornerWindow>(true, string("DC30"), string("DC26")), 6, 240, Series::DC,
+                 SlideCornerWindow::checkSpec });
+        put(s, { 0, "slide-corner-m", "Slide Corner Window (M section)", "subtype coller h w wr", 5,
+                 maker<SlideCornerWindow>(false, string("M30"), string("M26")), 6, 240, Series::M });
+        put(s, { 0, "bay", "Bay / Multi-segment Corner Window", "coller segments h tee", 1, maker<BayWindow>() });
+    }
 
-            cout << fixed << setprecision(2);
-            cout << s.first << ": " << inches << " inches = "
-                 << ft << " ft => rounded ft = " << rounded
-                 << " => Rs. " << price << "\n";
+public:
+    // Returns the new type id, or 0 when the name is taken or the registry is frozen.
+    static int add(WindowTypeInfo info) {
+        Storage& s = storage();
+        if (s.frozen.load(memory_order_acquire)) {
+            cerr << "⚠️ Window type '" << info.name << "' registered after startup, ignored.\n";
+            return 0;
         }
+        if (s.byName.count(info.name)) {
+            cerr << "⚠️ Window type name '" << info.name << "' is already registered.\n";
+            return 0;
+        }
+        put(s, move(info));
+        return static_cast<int>(s.types.size());
+    }
 
-        return total;
+    // For plug-in files: static ComponentRegistry::Registrar bay{{ ... }};
+    struct Registrar {
+        int id;
+        explicit Registrar(WindowTypeInfo info) : id(add(move(info))) {}
+    };
+
+    static void freeze() { storage().frozen.store(true, memory_order_release); }
+
+    static int count() { return static_cast<int>(storage().types.size()); }
+
+    static const WindowTypeInfo* find(int id) {
+        const Storage& s = storage();
+        return (id >= 1 && id <= static_cast<int>(s.types.size())) ? &s.types[id - 1] : nullptr;
     }
 
-private:
-  float roundToMarketFeet(float inches) const {
-    float ft = inches / 12.0f;
-    int fullFeet = static_cast<int>(ft);
+    static const WindowTypeInfo* find(const string& name) {
+        const Storage& s = storage();
+        auto it = s.byName.find(name);
+        return it == s.byName.end() ? nullptr : &s.types[it->second - 1];
+    }
 
-    // If inches divide perfectly → use as-is
-    if (fmod(inches, 12.0f) == 0.0f)
-        return fullFeet;
+    static void printMenu() {
+        for (const auto& t : storage().types) cout << t.id << ". " << t.displayName << "\n";
+    }
 
-    // Otherwise round up to next full foot
-    return fullFeet + 1.0f;
-}
+    static void printTable() {
+        cout << left << setw(5) << "Type" << setw(22) << "Name" << setw(46) << "Window"
+             << setw(9) << "Collars" << setw(11) << "Sizes (in)" << "Keys" << "\n";
+        for (const auto& t : storage().types)
+            cout << left << setw(5) << t.id << setw(22) << t.name << setw(46) << t.displayName
+                 << setw(9) << t.collars << setw(11) << (to_string((int)t.minInches) + "-" + to_string((int)t.maxInches))
+                 << t.inputs << "\n";
+        cout << right;
+    }
 };
 
+unique_ptr<FrameComponent> createComponent(int type) {
+    const WindowTypeInfo* info = ComponentRegistry::find(type);
+    return info ? info->make() : nullptr;
+}
+
+const char* windowTypeName(int type) {
+    const WindowTypeInfo* info = ComponentRegistry::find(type);
+    return info ? info->displayName.c_str() : "Unknown";
+}
+
 /////////////////////////////////////////////////////////
-// 🪟 Three and Two Panel Window Class and 3 glass part (Type 1 and 2 in M section)
+// 🗜️ Packed Window Specs (16 bytes per stored window)
 /////////////////////////////////////////////////////////
 
-class ThreePanel_3glass : public FrameComponent {
-    float height = 0, width = 0, netwidth = 0;
-    int collerType = 1, net = 2;
-    bool includeD29 = true; // 👈 You can toggle this based on window type
-    string prefix30 = "DC30", prefix26 = "DC26"; // 👈 Flexible prefix system
+inline Series seriesOf(int type) {
+    const WindowTypeInfo* info = ComponentRegistry::find(type);
+    return info ? info->series : Series::DC;
+}
+
+// Dimensions in sixteenths of an inch (tape-measure resolution, up to
+// 4095.9 inches); type, collar, options and series bit-packed into 32 bits.
+// 'extra' holds whichever of net width / D29 width / arch length the type uses.
+// A bay's segment list does not fit; it is numbered in the owning
+// PackedWindowStore's segment table (0 = none), the number split between
+// the top 14 bits and 'extra', which bays do not otherwise use.
+// Only specs that round-trip exactly are packed; see pack().
+struct PackedSpec {
+    uint16_t height, width, widthRight, tee, extra, rise;
+    uint32_t bits;
+
+    static constexpr float kUnit = 16.0f;
+    static constexpr uint32_t kMaxSegmentLists = (1u << 30) - 1;
+
+    // False when inches is off the 1/16" grid or out of range.
+    static bool quantize(float inches, uint16_t& out) {
+        float ticks = inches * kUnit;
+        if (!(ticks >= 0 && ticks <= 65535) || ticks != nearbyint(ticks)) return false;
+        out = static_cast<uint16_t>(ticks);
+        return true;
+    }
+
+    // Refuses (returns false, p unusable) any spec unpack() would not give
+    // back exactly: a size off the 1/16" grid such as a typed 37.3", a
+    // field past its bits, or bay segments without a segment list number.
+    static bool pack(const WindowSpec& s, PackedSpec& p, uint32_t segmentList = 0) {
+        if (s.type < 1 || s.type > 15 || s.collar < 0 || s.collar > 15 || s.netType < 0 || s.netType > 7 ||
+            s.archShape < 0 || s.archShape > 3)
+            return false;
+        if (s.type == 15 ? s.segments.empty() || segmentList == 0 || segmentList > kMaxSegmentLists
+                         : !s.segments.empty())
+            return false;
+
+        // 'extra' has room for one of arch / net width, and none for bays.
+        if ((s.type != 11 && s.arch != 0) || ((s.type == 11 || s.type == 15) && s.netWidth != 0)) return false;
+        float extra = s.type == 11 ? s.arch : s.type == 15 ? 0 : s.netWidth;
+
+        if (!quantize(s.height, p.height) || !quantize(s.width, p.width) ||
+            !quantize(s.widthRight, p.widthRight) || !quantize(s.tee, p.tee) ||
+            !quantize(extra, p.extra) || !quantize(s.rise, p.rise))
+            return false;
+
+        p.bits = (s.type & 0xF)
+               | (s.collar & 0xF) << 4
+               | (s.netType & 0x7) << 8
+               | uint32_t(s.includeTee) << 11
+               | uint32_t(s.hasNet) << 12
+               | uint32_t(s.includeD46) << 13
+               | uint32_t(s.hasColler) << 14
+               | (s.archShape & 0x3) << 15
+               | uint32_t(seriesOf(s.type)) << 17
+               | (segmentList >> 16 & 0x3FFF) << 18;
+        if (s.type == 15) p.extra = segmentList & 0xFFFF;
+        return true;
+    }
+
+    int type() const { return bits & 0xF; }
+    uint32_t segmentList() const { return type() == 15 ? (bits >> 18) << 16 | extra : 0; }
+    Series series() const { return static_cast<Series>((bits >> 17) & 1); }
+
+    WindowSpec unpack() const {
+        WindowSpec s;
+        s.type = type();
+        s.collar = (bits >> 4) & 0xF;
+        s.netType = (bits >> 8) & 0x7;
+        s.includeTee = (bits >> 11) & 1;
+        s.hasNet = (bits >> 12) & 1;
+        s.includeD46 = (bits >> 13) & 1;
+        s.hasColler = (bits >> 14) & 1;
+        s.archShape = (bits >> 15) & 0x3;
+
+        s.height = height / kUnit;
+        s.width = width / kUnit;
+        s.widthRight = widthRight / kUnit;
+        s.tee = tee / kUnit;
+        s.rise = rise / kUnit;
+        if (s.type == 11) s.arch = extra / kUnit;
+        else if (s.type != 15) s.netWidth = extra / kUnit;
+        return s;
+    }
+};
+
+static_assert(sizeof(PackedSpec) == 16, "PackedSpec must stay 16 bytes");
+
+// Windows kept as packed specs plus a small tag table; full objects are
+// built only while a window is being priced or displayed. A spec that
+// PackedSpec::pack() refuses is kept as it is (its slot has type 0), so
+// every window comes back exactly as it was added.
+class PackedWindowStore {
+    vector<PackedSpec> specs;
+    vector<uint16_t> tagIds;
+    vector<string> tags;
+    unordered_map<string, uint16_t> tagIndex;
+    vector<string> segmentLists = { "" };  // bay segments, shared by equal bays; [0] = none
+    unordered_map<string, uint32_t> segmentIndex;
+    unordered_map<size_t, WindowSpec> verbatim;  // slot -> spec that did not pack
+
+    uint32_t internSegments(const string& segments) {
+        if (segments.empty()) return 0;
+        auto it = segmentIndex.find(segments);
+        if (it != segmentIndex.end()) return it->second;
+        if (segmentLists.size() > PackedSpec::kMaxSegmentLists) return 0;  // table full: kept verbatim
+        uint32_t list = static_cast<uint32_t>(segmentLists.size());
+        segmentIndex.emplace(segments, list);
+        segmentLists.push_back(segments);
+        return list;
+    }
 
 public:
-    ThreePanel_3glass(bool useD29 = true, string p30 = "DC30", string p26 = "DC26")
-        : includeD29(useD29), prefix30(p30), prefix26(p26) {}
+    void reserve(size_t n) {
+        specs.reserve(n);
+        tagIds.reserve(n);
+    }
 
-    void inputDimensions() override {
-    if (includeD29) {
-        cout << "Net Types:\n";
-        cout << "1 - Single net (auto width)\n";
-        cout << "2 - Double net (auto width)\n";
-        cout << "3 - Custom single net\n";
-        cout << "4 - Custom double net\n";
-        cin >> net;
+    // Returns the window's slot. packed is false when the spec was kept
+    // as it is instead of in 16 bytes.
+    size_t add(const WindowSpec& spec, const string& tag = "-", bool* packed = nullptr) {
+        PackedSpec p{};
+        bool exact = PackedSpec::pack(spec, p, internSegments(spec.type == 15 ? spec.segments : ""));
+        if (!exact) {
+            p = PackedSpec{};
+            verbatim.emplace(specs.size(), spec);
+        }
+        if (packed) *packed = exact;
 
-        if (net == 3 || net == 4) {
-            do {
-                cout << "Enter the width size of net (in inches): ";
-                cin >> netwidth;
-            } while (netwidth <= 0);
+        auto it = tagIndex.find(tag);
+        if (it == tagIndex.end()) {
+            it = tagIndex.emplace(tag, static_cast<uint16_t>(tags.size())).first;
+            tags.push_back(tag);
         }
+
+        specs.push_back(p);
+        tagIds.push_back(it->second);
+        return specs.size() - 1;
     }
 
-    do {
-        cout << "Enter Coller Type (1 to 14): ";
-        cin >> collerType;
-    } while (collerType < 1 || collerType > 14);
+    size_t size() const { return specs.size(); }
+    size_t verbatimCount() const { return verbatim.size(); }
+    const string& tag(size_t i) const { return tags[tagIds[i]]; }
 
-    do {
-        cout << "Enter height (in inches): ";
-        cin >> height;
-    } while (height <= 0);
+    WindowSpec unpack(size_t i) const {
+        if (specs[i].type() == 0) return verbatim.at(i);
+        WindowSpec s = specs[i].unpack();
+        s.segments = segmentLists[specs[i].segmentList()];
+        return s;
+    }
 
-    do {
-        cout << "Enter width (in inches): ";
-        cin >> width;
-    } while (width <= 0);
-}
+    unique_ptr<FrameComponent> materialize(size_t i) const {
+        WindowSpec s = unpack(i);
+        auto win = createComponent(s.type);
+        if (win) win->loadSpec(s);
+        return win;
+    }
 
-    void displayType() const override {
-        cout << "Three Panel and 3 Glass Part Window\n";
+    size_t bytes() const {
+        size_t total = specs.capacity() * sizeof(PackedSpec) + tagIds.capacity() * sizeof(uint16_t);
+        for (const auto& t : tags) total += sizeof(string) + t.capacity();
+        for (const auto& l : segmentLists) total += sizeof(string) + l.capacity();
+        for (const auto& v : verbatim) total += sizeof(v) + 2 * sizeof(void*) + v.second.segments.capacity();
+        return total;
     }
 
-    float getArea() const override {
-        return (height / 12.0f) * (width / 12.0f);
+    // Packs count random windows, then checks a sample of them against the
+    // specs they were added from.
+    static void benchmark(size_t count);
+};
+
+// A priced window as stored by main(): the rates it was priced with stay
+// attached so the project can be re-summarised later. Imported windows are
+// packed (see pack()) and have no object until one is asked for.
+struct QuoteEntry {
+    unique_ptr<FrameComponent> window;  // null while packed
+    int type = 0;
+    string tag = "-";  // site/floor/room path, see ProjectTree
+    shared_ptr<const RateTable> rates;
+    int treeId = -1;   // ProjectTree window id
+    const PackedWindowStore* packedIn = nullptr;
+    size_t packedAt = 0;
+
+    // Drops the object (and its section map) and keeps spec in store.
+    void pack(PackedWindowStore& store, const WindowSpec& spec) {
+        packedAt = store.add(spec, tag);
+        packedIn = &store;
+        window.reset();
     }
 
-    map<string, float> getRequiredSections() const override {
-        map<string, float> sections;
-        float h = height, w = width, n = netwidth;
+    // The window to read from. A packed one is rebuilt into scratch, which
+    // must outlive the reference; reuse it across a loop.
+    const FrameComponent& view(unique_ptr<FrameComponent>& scratch) const {
+        if (window) return *window;
+        scratch = packedIn->materialize(packedAt);
+        return *scratch;
+    }
 
-        // Build section keys based on coller type
-        auto sec = [&](string base) -> string {
-            return (collerType == 2 || collerType == 5 || collerType == 8 || collerType == 10 || collerType == 11 || collerType == 12)
-                   ? prefix30 + "C"
-                   : prefix30 + "F";
-        };
+    // The window as an object of its own again, for editing.
+    FrameComponent& own() {
+        if (!window) {
+            window = packedIn->materialize(packedAt);
+            packedIn = nullptr;
+        }
+        return *window;
+    }
+};
 
-        switch (collerType) {
-            case 1:  sections[prefix30 + "F"] = (h * 2) + w + 9; sections[prefix26 + "F"] = w + 3;                                         break;
-            case 2:  sections[prefix30 + "C"] = (h * 2) + w;     sections[prefix26 + "C"] = w;                                             break;
-            case 3:  sections[prefix30 + "C"] = w;               sections[prefix30 + "F"] = (h * 2) + 6; sections[prefix26 + "F"] = w + 3; break;
-            case 4:  sections[prefix30 + "C"] = h;               sections[prefix30 + "F"] = (h + w) + 6; sections[prefix26 + "F"] = w + 3; break;
-            case 5:  sections[prefix30 + "F"] = (h * 2) + w + 9; sections[prefix26 + "C"] = w;                                             break;
-            case 6:  sections[prefix30 + "C"] = h;               sections[prefix30 + "F"] = (h + w) + 6; sections[prefix26 + "F"] = w + 3; break;
-            case 7:  sections[prefix30 + "C"] = h + w;           sections[prefix30 + "F"] = h + 3;       sections[prefix26 + "F"] = w + 3; break;
-            case 8:  sections[prefix30 + "C"] = h;               sections[prefix30 + "F"] = (h + w) + 6; sections[prefix26 + "C"] = w; break;
-            case 9:  sections[prefix30 + "C"] = h * 2;           sections[prefix30 + "F"] = w + 3;       sections[prefix26 + "F"] = w + 3; break;
-            case 10: sections[prefix30 + "C"] = w;               sections[prefix30 + "F"] = (h * 2) + 6; sections[prefix26 + "C"] = w; break;
-            case 11: sections[prefix30 + "C"] = h * 2;           sections[prefix30 + "F"] = w + 3;       sections[prefix26 + "C"] = w; break;
-            case 12: sections[prefix30 + "C"] = w + h;           sections[prefix30 + "F"] = h + 3;       sections[prefix26 + "C"] = w; break;
-            case 13: sections[prefix30 + "C"] = (h * 2) + w;     sections[prefix26 + "F"] = w + 3;                                     break;
-            case 14: sections[prefix30 + "C"] = h + w;           sections[prefix30 + "F"] = h + 3;       sections[prefix26 + "F"] = w; break;
+/////////////////////////////////////////////////////////
+// 🔩 Hardware Kits (rollers, locks, hinges... per window)
+/////////////////////////////////////////////////////////
+
+// Part -> quantity, open addressing with linear probing. Sized up front
+// for the expected number of distinct parts so aggregation never rehashes
+// and each part line costs one hash and usually one probe.
+class PartTable {
+    struct Slot {
+        uint64_t hash = 0;  // 0 = empty
+        const char* part = nullptr;
+        float qty = 0;
+    };
+    vector<Slot> slots;
+    size_t used = 0;
+
+    static uint64_t hash(const char* part) {
+        uint64_t h = 1469598103934665603ULL;
+        for (; *part; ++part) {
+            h ^= static_cast<unsigned char>(*part);
+            h *= 1099511628211ULL;
         }
+        return h | 1;
+    }
 
-        // Common sections
-        sections["M23"] = h * 2;
-        sections["M28"] = h * 4;
-        sections["M24"] = w * 2;
+    size_t slotFor(const char* part, uint64_t h) const {
+        size_t mask = slots.size() - 1;
+        size_t i = h & mask;
+        while (slots[i].hash && (slots[i].hash != h || strcmp(slots[i].part, part) != 0)) i = (i + 1) & mask;
+        return i;
+    }
 
-        // Optional D29 section
-        if (includeD29) {
-            switch (net) {
-                case 1: sections["D29"] = (h + (w / 3)) * 2; break;
-                case 2: sections["D29"] = (h * 4) + w;       break;
-                case 3: sections["D29"] = (h * 2) + (n * 2); break;
-                case 4: sections["D29"] = (h * 4) + (n * 4); break;
+    void grow() {
+        vector<Slot> old(slots.size() * 2);
+        old.swap(slots);
+        for (const Slot& s : old)
+            if (s.hash) slots[slotFor(s.part, s.hash)] = s;
+    }
+
+public:
+    explicit PartTable(size_t expectedParts = 64) {
+        size_t capacity = 16;
+        while (capacity < expectedParts * 2) capacity *= 2;  // load stays under 1/2
+        slots.resize(capacity);
+    }
+
+    void add(const char* part, float qty) {
+        uint64_t h = hash(part);
+        size_t i = slotFor(part, h);
+        if (!slots[i].hash) {
+            if ((used + 1) * 10 > slots.size() * 7) {  // only if the estimate was wrong
+                grow();
+                i = slotFor(part, h);
             }
+            slots[i] = { h, part, 0 };
+            ++used;
         }
+        slots[i].qty += qty;
+    }
 
-        return sections;
+    const float* find(const char* part) const {
+        const Slot& s = slots[slotFor(part, hash(part))];
+        return s.hash ? &s.qty : nullptr;
     }
 
-    float calculateTotalPrice(const map<string, float>& rates) const override {
-        auto sections = getRequiredSections();
+    size_t size() const { return used; }
+
+    // Parts in name order, for reports.
+    vector<pair<string, float>> sorted() const {
+        vector<pair<string, float>> rows;
+        for (const Slot& s : slots)
+            if (s.hash) rows.push_back({ s.part, s.qty });
+        sort(rows.begin(), rows.end());
+        return rows;
+    }
+};
+
+// hardware_prices.csv: part,price per piece (or per ft for "(ft)" parts).
+// When it exists, the Final Summary charges kits instead of the flat
+// hardware rate per window.
+class HardwareKits {
+    static constexpr size_t kCatalogSize = 32;  // distinct parts the window types use
+
+    list<string> names;  // stable storage for price table keys
+    PartTable prices{ kCatalogSize };
+
+public:
+    bool loadPrices(const string& path = "hardware_prices.csv") {
+        string text;
+        if (!SessionJournal::get().readFile(path, text)) return false;
+        istringstream in(text);
+
+        string line;
+        int lineNo = 0;
+        while (getline(in, line)) {
+            ++lineNo;
+            if (line.empty() || line[0] == '#') continue;
+
+            string part, priceText;
+            istringstream fields(line);
+            getline(fields, part, ',');
+            getline(fields, priceText);
+
+            char* end = nullptr;
+            float price = strtof(priceText.c_str(), &end);
+            if (part.empty() || end == priceText.c_str() || price < 0) {
+                if (lineNo > 1)  // first line may be a header
+                    cerr << "⚠️ Skipping line " << lineNo << " of " << path << ": " << line << "\n";
+                continue;
+            }
+            if (prices.find(part.c_str())) continue;  // first price wins
+            names.push_back(part);
+            prices.add(names.back().c_str(), price);
+        }
+        return prices.size() > 0;
+    }
+
+    bool hasPrices() const { return prices.size() > 0; }
+
+    float price(const char* part) const {
+        const float* p = prices.find(part);
+        return p ? *p : 0;
+    }
+
+    // Cost of one window's kit; unpriced parts count as zero.
+    float windowCost(const FrameComponent& win, vector<HardwareLine>& scratch) const {
+        scratch.clear();
+        win.getHardware(scratch);
+        float cost = 0;
+        for (const HardwareLine& line : scratch) cost += line.qty * price(line.part);
+        return cost;
+    }
+
+    // One pass over the project, one reused line buffer.
+    static PartTable aggregate(const vector<QuoteEntry>& windows) {
+        PartTable totals(kCatalogSize);
+        vector<HardwareLine> kit;
+        unique_ptr<FrameComponent> scratch;
+        for (const auto& entry : windows) {
+            kit.clear();
+            entry.view(scratch).getHardware(kit);
+            for (const HardwareLine& line : kit) totals.add(line.part, line.qty);
+        }
+        return totals;
+    }
+
+    float projectCost(const PartTable& totals) const {
+        float cost = 0;
+        for (const auto& row : totals.sorted()) cost += row.second * price(row.first.c_str());
+        return cost;
+    }
+
+    void report(const vector<QuoteEntry>& windows) const {
+        PartTable totals = aggregate(windows);
+
+        cout << fixed << setprecision(2);
+        cout << "\n=== Hardware Kits (" << windows.size() << " window(s)) ===\n";
+        cout << left << setw(26) << "Part" << right << setw(12) << "Qty" << setw(12) << "Price" << setw(14) << "Cost" << "\n";
+
         float total = 0;
+        vector<string> unpriced;
+        for (const auto& row : totals.sorted()) {
+            const float* p = prices.find(row.first.c_str());
+            if (!p) unpriced.push_back(row.first);
+            float cost = p ? row.second * *p : 0;
+            total += cost;
+            cout << left << setw(26) << row.first << right << setw(12) << row.second;
+            if (p) cout << setw(12) << *p << setw(14) << cost << "\n";
+            else cout << setw(12) << "-" << setw(14) << "-" << "\n";
+        }
+        cout << "Hardware total: Rs. " << total << "\n";
+        if (!unpriced.empty())
+            cout << "⚠️ " << unpriced.size() << " part(s) have no price in hardware_prices.csv\n";
+    }
+
+    // Expands N synthetic windows' kits and aggregates the part lines.
+    static void benchmark(size_t count);
+};
+
+/////////////////////////////////////////////////////////
+// 📊 Project Summary Engine (single pass, many rate sets)
+/////////////////////////////////////////////////////////
 
-        for (const auto& s : sections) {
-            float inches = s.second;
-            float feet = inches / 12.0f;
-            float roundedFeet = roundToMarketFeet(inches);
+class ProjectSummary {
+    // Everything the cost rates are applied to. Glass, labor, hardware and
+    // discount are linear in these, so any number of rate sets can be
+    // evaluated from the same buckets without touching the windows again.
+    struct Bucket {
+        float aluminium = 0, sqft = 0, inches = 0;
+        float kitHardware = 0;  // only when kit prices were given to add()
+        int windows = 0;
+    };
 
-            float price = roundedFeet * rates.at(s.first);
-            total += price;
+    Bucket project;
+    map<string, Bucket> byType, byTag, byProfile;
+    bool kitPriced = false;
+    vector<HardwareLine> kitScratch;
+    unique_ptr<FrameComponent> windowScratch;  // packed windows, see QuoteEntry::view
+
+    void printRow(const string& label, const Bucket& b, const CostRates& r, bool profileRow) const {
+        float discount = (r.discountPercent / 100.0f) * b.aluminium;
+        float glass = profileRow ? 0 : r.glassRate * b.sqft;
+        float labor = profileRow ? 0 : r.laborRate * b.sqft;
+        float hardware = profileRow ? 0 : kitPriced ? b.kitHardware : r.hardwareRate * b.windows;
+        float net = b.aluminium - discount + glass + labor + hardware;
+
+        cout << left << setw(44) << label << right
+             << setw(6) << b.windows
+             << setw(12) << b.aluminium
+             << setw(11) << discount
+             << setw(11) << glass
+             << setw(11) << labor
+             << setw(11) << hardware
+             << setw(13) << net << "\n";
+    }
+
+    void printTable(const string& title, const map<string, Bucket>& rows, const CostRates& r, bool profileRows) const {
+        cout << "\n" << title << "\n";
+        cout << left << setw(44) << (profileRows ? "Profile" : "Group") << right
+             << setw(6) << (profileRows ? "Uses" : "Qty")
+             << setw(12) << "Aluminium" << setw(11) << "Discount"
+             << setw(11) << "Glass" << setw(11) << "Labor"
+             << setw(11) << "Hardware" << setw(13) << "Net" << "\n";
+        for (const auto& row : rows) printRow(row.first, row.second, r, profileRows);
+    }
 
-            cout << fixed << setprecision(2);
-            cout << s.first << ": " << inches << " inches = " << feet << " ft => rounded ft = "
-                 << roundedFeet << " => Rs. " << price << "\n";
+public:
+    // With kits, hardware columns use the window's priced kit instead of
+    // the flat rate; pass them for every window or for none.
+    void add(const QuoteEntry& entry, const HardwareKits* kits = nullptr) {
+        const FrameComponent& win = entry.view(windowScratch);
+        float sqft = win.getArea();
+        float aluminium = 0;
+        float hardware = kits ? kits->windowCost(win, kitScratch) : 0;
+        kitPriced = kits != nullptr;
+
+        for (const auto& s : win.requiredSections()) {
+            float cost;
+            if (!win.sectionCost(s.id, s.second, *entry.rates, cost)) continue;
+
+            Bucket& profile = byProfile[s.first];
+            profile.aluminium += cost;
+            profile.inches += s.second;
+            profile.windows++;
+            aluminium += cost;
         }
 
-        return total;
+        for (Bucket* b : { &project, &byType[windowTypeName(entry.type)], &byTag[entry.tag] }) {
+            b->aluminium += aluminium;
+            b->sqft += sqft;
+            b->kitHardware += hardware;
+            b->windows++;
+        }
     }
 
-private:
-    float roundToMarketFeet(float inches) const {
-        float ft = inches / 12.0f;
-        int whole = static_cast<int>(floor(ft));
-        float inch = (ft - whole) * 12;
-
-        if (inch <= 6.0f)
-            return whole + 0.6f;
-        else
-            return whole + 1.0f;
+    float aluminium() const { return project.aluminium; }
+    float sqft() const { return project.sqft; }
+    int windows() const { return project.windows; }
+    float kitHardware() const { return kitPriced ? project.kitHardware : -1; }
+
+    void report(const CostRates& r) const {
+        cout << fixed << setprecision(2);
+        cout << "\n=== Project Breakdown (" << r.name << ") ===\n";
+        printTable("By window type:", byType, r, false);
+        printTable("By floor/tag:", byTag, r, false);
+        printTable("By profile (aluminium only):", byProfile, r, true);
+
+        cout << "\nProfile lengths:\n";
+        for (const auto& row : byProfile)
+            cout << "  " << row.first << ": " << row.second.inches << " inches ("
+                 << row.second.inches / 12.0f << " ft)\n";
     }
 };
 
 /////////////////////////////////////////////////////////
-// 🪟 Fix Window With or Without Tee
+// 🏢 Project Tree (site -> floor -> room subtotals)
 /////////////////////////////////////////////////////////
 
-class FixWindow : public FrameComponent {
-    float height = 0, width = 0, tee = 0;
-    int collerType = 1;
-    bool includeTee = false;
-
+// A window's tag is its place in the building, one level per '/':
+// "TowerA/F2/Kitchen". Every node keeps running totals of the windows under
+// it, so a subtotal is one hash lookup and adding, editing or removing a
+// window only touches the nodes on its path. Totals are doubles because
+// edits subtract exactly what inserts added; floats would drift.
+class ProjectTree {
 public:
-    void inputDimensions() override {
-        char tOption;
-        cout << "Include Tee? (y/n): ";
-        cin >> tOption;
-        includeTee = (tOption == 'y' || tOption == 'Y');
+    struct Totals {
+        double aluminium = 0, sqft = 0, kitHardware = 0;
+        int windows = 0;
+        vector<double> profileInches;  // bill of materials, by profile id
+    };
 
-        do {
-            cout << "Enter Coller Type (1 to 14): ";
-            cin >> collerType;
-        } while (collerType < 1 || collerType > 14);
+private:
+    struct Node {
+        string name, path;
+        int parent = -1, depth = 0;
+        map<string, int> children;
+        Totals totals;
+    };
 
-        do {
-            cout << "Enter height (in inches): ";
-            cin >> height;
-        } while (height <= 0);
+    // What one window adds to each node on its path; kept so the exact same
+    // amounts come off again on edit or remove.
+    struct Contribution {
+        int node = -1;  // -1 once removed
+        double aluminium = 0, sqft = 0, kitHardware = 0;
+        vector<pair<int, float>> profiles;
+    };
 
-        do {
-            cout << "Enter width (in inches): ";
-            cin >> width;
-        } while (width <= 0);
+    vector<Node> nodes;  // nodes[0] is the whole project
+    unordered_map<string, int> byPath;
+    vector<Contribution> placed;  // by window id
+    vector<string> profileNames;
+    unordered_map<string, int> profileIds;
+    HardwareKits kits;
+    bool kitPriced = false;
+    vector<HardwareLine> kitScratch;
+
+    int profileId(const string& code) {
+        auto it = profileIds.find(code);
+        if (it != profileIds.end()) return it->second;
+        profileIds.emplace(code, (int)profileNames.size());
+        profileNames.push_back(code);
+        return (int)profileNames.size() - 1;
+    }
 
-        if (includeTee) {
-            do {
-                cout << "Enter Tee size (in inches): ";
-                cin >> tee;
-            } while (tee <= 0);
+    // "-" and "" are the project itself; "GF" is a top-level node.
+    int nodeFor(const string& tag) {
+        if (tag.empty() || tag == "-") return 0;
+        auto found = byPath.find(tag);
+        if (found != byPath.end()) return found->second;
+
+        int node = 0;
+        size_t begin = 0;
+        while (begin <= tag.size()) {
+            size_t end = min(tag.find('/', begin), tag.size());
+            string name = tag.substr(begin, end - begin);
+            begin = end + 1;
+            if (name.empty()) continue;
+
+            auto child = nodes[node].children.find(name);
+            if (child != nodes[node].children.end()) {
+                node = child->second;
+                continue;
+            }
+            Node n;
+            n.name = name;
+            n.path = node == 0 ? name : nodes[node].path + "/" + name;
+            n.parent = node;
+            n.depth = nodes[node].depth + 1;
+            int id = (int)nodes.size();
+            nodes[node].children.emplace(name, id);
+            byPath.emplace(n.path, id);
+            nodes.push_back(move(n));
+            node = id;
         }
+        byPath.emplace(tag, node);  // "F1//Hall" and "F1/Hall/" find the same node next time
+        return node;
     }
 
-    void displayType() const override {
-        cout << "Fixed Window";
-        if (includeTee) cout << " with Tee";
-        cout << "\n";
+    Contribution measure(const QuoteEntry& entry) {
+        Contribution c;
+        unique_ptr<FrameComponent> scratch;
+        const FrameComponent& win = entry.view(scratch);
+        c.node = nodeFor(entry.tag);
+        c.sqft = win.getArea();
+        if (kitPriced) c.kitHardware = kits.windowCost(win, kitScratch);
+        for (const auto& s : win.requiredSections()) {
+            c.profiles.emplace_back(profileId(s.first), s.second);
+            float cost;
+            if (win.sectionCost(s.id, s.second, *entry.rates, cost)) c.aluminium += cost;
+        }
+        return c;
     }
 
-    float getArea() const override {
-        return (height / 12.0f) * (width / 12.0f);
+    void apply(const Contribution& c, int sign) {
+        for (int n = c.node; n >= 0; n = nodes[n].parent) {
+            Totals& t = nodes[n].totals;
+            t.aluminium += sign * c.aluminium;
+            t.sqft += sign * c.sqft;
+            t.kitHardware += sign * c.kitHardware;
+            t.windows += sign;
+            for (const auto& p : c.profiles) {
+                if (t.profileInches.size() <= (size_t)p.first) t.profileInches.resize(p.first + 1, 0.0);
+                t.profileInches[p.first] += sign * p.second;
+            }
+        }
     }
 
-    map<string, float> getRequiredSections() const override {
-        map<string, float> sections;
-        float h = height, w = width, t = tee;
+    void printRow(const Node& n, const CostRates& r) const {
+        const Totals& t = n.totals;
+        double discount = (r.discountPercent / 100.0) * t.aluminium;
+        double hardware = kitPriced ? t.kitHardware : (double)r.hardwareRate * t.windows;
+        double net = t.aluminium - discount + (r.glassRate + r.laborRate) * t.sqft + hardware;
+        string label = string(2 * n.depth, ' ') + (n.depth == 0 ? "Project" : n.name);
+        cout << left << setw(36) << label << right << setw(6) << t.windows << setw(12) << t.aluminium
+             << setw(10) << t.sqft << setw(11) << r.glassRate * t.sqft << setw(11) << r.laborRate * t.sqft
+             << setw(11) << hardware << setw(13) << net << "\n";
+    }
 
-        // Apply formulas based on coller type
-        switch (collerType) {
-            case 1:  sections["D54F"] = (h + w) * 2 + 12;                        break;
-            case 2:  sections["D54A"] = (h + w) * 2;                              break;
-            case 3:  sections["D54F"] = (h * 2) + w + 9;  sections["D54A"] = w;    break;
-            case 4:  sections["D54F"] = (w * 2) + h + 9;  sections["D54A"] = h;    break;
-            case 5:  sections["D54F"] = (h * 2) + w + 9;  sections["D54A"] = w;    break;
-            case 6:  sections["D54F"] = (w * 2) + h + 9;  sections["D54A"] = h;    break;
-            case 7:  sections["D54F"] = h + w + 6;        sections["D54A"] = h + w; break;
-            case 8:  sections["D54F"] = h + w + 6;        sections["D54A"] = h + w; break;
-            case 9:  sections["D54F"] = (h * 2) + 6;      sections["D54A"] = w * 2; break;
-            case 10: sections["D54F"] = (w * 2) + 6;      sections["D54A"] = h * 2; break;
-            case 11: sections["D54F"] = w + 3;            sections["D54A"] = (h * 2) + w; break;
-            case 12: sections["D54F"] = h * 3;            sections["D54A"] = (w * 2) + h; break;
-            case 13: sections["D54F"] = w + 3;            sections["D54A"] = (h * 2) + w; break;
-            case 14: sections["D54F"] = h + 3;            sections["D54A"] = (w * 2) + h; break;
-        }
+    void printBranch(int node, const CostRates& r, int maxDepth) const {
+        const Node& n = nodes[node];
+        if (n.totals.windows == 0 && node != 0) return;
+        printRow(n, r);
+        if (n.depth >= maxDepth) return;
+        for (const auto& child : n.children) printBranch(child.second, r, maxDepth);
+    }
 
-        if (includeTee) {
-            sections["D52"] = t;
-            sections["D41"] = ((h + w) * 2) + (t * 2);
-        } else {
-            sections["D41"] = (h + w) * 2;
-        }
+public:
+    // Hardware subtotals use kit prices when hardware_prices.csv exists.
+    ProjectTree() : nodes(1) {
+        kitPriced = kits.loadPrices();
+        byPath.emplace("-", 0);
+    }
 
-        return sections;
+    // Returns the window id used by update() and remove().
+    int insert(const QuoteEntry& entry) {
+        placed.push_back(measure(entry));
+        apply(placed.back(), +1);
+        return (int)placed.size() - 1;
     }
 
-    float calculateTotalPrice(const map<string, float>& rates) const override {
-        auto sections = getRequiredSections();
-        float total = 0;
+    // New tag, dimensions or rates: old amounts off the old path, new on.
+    void update(int id, const QuoteEntry& entry) {
+        if (id < 0 || id >= (int)placed.size() || placed[id].node < 0) return;
+        apply(placed[id], -1);
+        placed[id] = measure(entry);
+        apply(placed[id], +1);
+    }
 
-        for (const auto& s : sections) {
-            float inches = s.second;
-            float feet = inches / 12.0f;
-            float roundedFeet = roundToMarketFeet(inches);
+    void remove(int id) {
+        if (id < 0 || id >= (int)placed.size() || placed[id].node < 0) return;
+        apply(placed[id], -1);
+        placed[id] = Contribution();
+    }
 
-            float price = 0;
-            try {
-                price = roundedFeet * rates.at(s.first);
-            } catch (const std::out_of_range&) {
-                cout << "⚠️ Rate missing for section: " << s.first << "\n";
-                continue;
-            }
+    const Totals& project() const { return nodes[0].totals; }
 
-            total += price;
-            cout << fixed << setprecision(2);
-            cout << s.first << ": " << inches << " inches = "
-                 << feet << " ft => rounded = " << roundedFeet
-                 << " => Rs. " << price << "\n";
-        }
+    // Subtotal of a site, floor or room; nullptr for unknown paths.
+    const Totals* find(const string& path) const {
+        auto it = byPath.find(path.empty() ? "-" : path);
+        return it == byPath.end() ? nullptr : &nodes[it->second].totals;
+    }
 
-        return total;
+    const string& profileName(int id) const { return profileNames[id]; }
+
+    void report(const CostRates& r, int maxDepth = 8) const {
+        cout << fixed << setprecision(2);
+        cout << "\n=== Project Tree (" << r.name << ") ===\n";
+        cout << left << setw(36) << "Location" << right << setw(6) << "Qty" << setw(12) << "Aluminium"
+             << setw(10) << "SqFt" << setw(11) << "Glass" << setw(11) << "Labor"
+             << setw(11) << (kitPriced ? "Kits" : "Hardware") << setw(13) << "Net" << "\n";
+        printBranch(0, r, maxDepth);
     }
 
-private:
-    float roundToMarketFeet(float inches) const {
-        float ft = inches / 12.0f;
-        int whole = static_cast<int>(floor(ft));
-        float inch = (ft - whole) * 12;
-        return (inch <= 6.0f) ? (whole + 0.6f) : (whole + 1.0f);
+    void printBom(const string& path) const {
+        const Totals* t = find(path);
+        if (!t || t->windows == 0) {
+            cout << "⚠️ No windows at '" << path << "'.\n";
+            return;
+        }
+        cout << fixed << setprecision(2);
+        cout << "\n--- " << (path.empty() || path == "-" ? "Project" : path) << ": " << t->windows
+             << " window(s), " << t->sqft << " sqft, aluminium Rs. " << t->aluminium << " ---\n";
+        for (size_t p = 0; p < t->profileInches.size(); ++p)
+            if (t->profileInches[p] > 0.005)
+                cout << "  " << left << setw(10) << profileNames[p] << right << setw(12) << t->profileInches[p]
+                     << " inches (" << t->profileInches[p] / 12.0 << " ft)\n";
+        if (kitPriced) cout << "  Hardware kits: Rs. " << t->kitHardware << "\n";
     }
+
+    // Inserts N synthetic windows across sites, floors and rooms, then
+    // times edits, moves, removals and subtotal lookups.
+    static void benchmark(size_t count);
 };
 
 /////////////////////////////////////////////////////////
-// 🪟 Random design Fix Window With or Without Tee
+// 🎯 Cost Sensitivity & Attribution (what drives the quote)
 /////////////////////////////////////////////////////////
 
-class RandomFixWindow : public FrameComponent {
-    float length = 0, tee = 0;
-    bool includeTee = false;
+// Net = (1 - d) * sum(feet * rate) + (glass + labor) * sqft + hardware * windows
+// is linear in every rate, so its partial derivatives are plain sums:
+//   dNet/d(rate of profile s) = (1 - d) * rounded feet of s over the project
+//   dNet/d(glass or labor)    = project sqft
+//   dNet/d(hardware)          = window count
+//   dNet/d(discount %)        = -aluminium / 100
+// With kit prices loaded, hardware is each window's kit cost instead, as in
+// the Final Summary. Dimensions go through market rounding, so their slope
+// is measured as the change in net total for one extra inch of height or
+// width; drawn arches take their height from the span and rise, and bays
+// their width from the segments, so those slopes are shown as n/a.
+class CostSensitivity {
+    static constexpr float kStepInches = 1.0f;
+
+    // One row per (window, section) with a known rate, flattened so the
+    // totals below are straight loops over contiguous arrays.
+    vector<int> rowWindow, rowProfile;
+    vector<float> rowFeet, rowRate, rowCost;
+
+    vector<string> profileNames;
+    unordered_map<string, int> profileIds;
+
+    // Per window: undiscounted aluminium, area, and their change for one
+    // step of height (H) or width (W).
+    vector<float> windowAluminium, windowSqFt, windowHardware;
+    vector<float> slopeHeight, slopeWidth, areaSlopeHeight, areaSlopeWidth;
+    vector<float> hardwareSlopeHeight, hardwareSlopeWidth;
+    vector<char> hasHeightSlope, hasWidthSlope;
+    vector<string> windowLabels;
+    bool kitPriced = false;
+
+    int profileId(const string& code) {
+        auto it = profileIds.find(code);
+        if (it != profileIds.end()) return it->second;
+        profileIds.emplace(code, static_cast<int>(profileNames.size()));
+        profileNames.push_back(code);
+        return static_cast<int>(profileNames.size()) - 1;
+    }
 
-public:
-    void inputDimensions() override {
-        char tOption;
-        cout << "Include Tee? (y/n): ";
-        cin >> tOption;
-        includeTee = (tOption == 'y' || tOption == 'Y');
+    // Aluminium (undiscounted), area and kit hardware of the same window
+    // with one dimension grown by a step. Unknown rates count as zero, as
+    // in pricing.
+    static void perturbed(const QuoteEntry& entry, bool height, const HardwareKits* kits,
+                          vector<HardwareLine>& scratch, float& aluminium, float& sqft, float& hardware) {
+        aluminium = sqft = hardware = 0;
+        auto probe = createComponent(entry.type);
+        if (!probe) return;
+
+        unique_ptr<FrameComponent> window;
+        WindowSpec spec = entry.view(window).getSpec();
+        spec.type = entry.type;
+        (height ? spec.height : spec.width) += kStepInches;
+        probe->loadSpec(spec);
+        aluminium = probe->aluminiumCost(*entry.rates);
+        sqft = probe->getArea();
+        if (kits) hardware = kits->windowCost(*probe, scratch);
+    }
 
-        do {
-            cout << "Enter total length (in inches): ";
-            cin >> length;
-            if (length <= 0) cout << "❌ Length must be greater than 0.\n";
-        } while (length <= 0);
+public:
+    // kits: hardware priced from kit prices (see HardwareKits), or nullptr
+    // for the flat per-window rate.
+    void build(const vector<QuoteEntry>& windows, const HardwareKits* kits = nullptr) {
+        size_t n = windows.size();
+        kitPriced = kits != nullptr;
+        windowAluminium.assign(n, 0);
+        windowSqFt.assign(n, 0);
+        windowHardware.assign(n, 0);
+        slopeHeight.assign(n, 0);
+        slopeWidth.assign(n, 0);
+        areaSlopeHeight.assign(n, 0);
+        areaSlopeWidth.assign(n, 0);
+        hardwareSlopeHeight.assign(n, 0);
+        hardwareSlopeWidth.assign(n, 0);
+        hasHeightSlope.assign(n, 0);
+        hasWidthSlope.assign(n, 0);
+        windowLabels.resize(n);
+        vector<HardwareLine> scratch;
+        unique_ptr<FrameComponent> windowScratch;
+
+        for (size_t i = 0; i < n; ++i) {
+            const QuoteEntry& entry = windows[i];
+            const FrameComponent& win = entry.view(windowScratch);
+            windowLabels[i] = "#" + to_string(i + 1) + " " + windowTypeName(entry.type) +
+                              (entry.tag != "-" ? " [" + entry.tag + "]" : "");
+            windowSqFt[i] = win.getArea();
+            if (kits) windowHardware[i] = kits->windowCost(win, scratch);
+            hasHeightSlope[i] = win.drivesHeight();
+            hasWidthSlope[i] = win.drivesWidth();
+
+            for (const auto& s : win.requiredSections()) {
+                float rate = entry.rates->rate(s.id);
+                if (isnan(rate)) continue;
+                rowWindow.push_back(static_cast<int>(i));
+                rowProfile.push_back(profileId(s.first));
+                rowFeet.push_back(win.roundToMarketFeet(s.second));
+                rowRate.push_back(rate);
+            }
+        }
 
-        if (includeTee) {
-            do {
-                cout << "Enter Tee size (in inches): ";
-                cin >> tee;
-                if (tee <= 0) cout << "❌ Tee size must be greater than 0.\n";
-            } while (tee <= 0);
+        // Costs and per-window totals over the flat rows.
+        size_t rows = rowFeet.size();
+        rowCost.resize(rows);
+        for (size_t r = 0; r < rows; ++r) rowCost[r] = rowFeet[r] * rowRate[r];
+        for (size_t r = 0; r < rows; ++r) windowAluminium[rowWindow[r]] += rowCost[r];
+
+        // Dimension slopes stay per window: aluminium and area deltas here,
+        // rates applied in report().
+        for (size_t i = 0; i < n; ++i) {
+            float aluminium, sqft, hardware;
+            if (hasHeightSlope[i]) {
+                perturbed(windows[i], true, kits, scratch, aluminium, sqft, hardware);
+                slopeHeight[i] = aluminium - windowAluminium[i];
+                areaSlopeHeight[i] = sqft - windowSqFt[i];
+                hardwareSlopeHeight[i] = hardware - windowHardware[i];
+            }
+            if (hasWidthSlope[i]) {
+                perturbed(windows[i], false, kits, scratch, aluminium, sqft, hardware);
+                slopeWidth[i] = aluminium - windowAluminium[i];
+                areaSlopeWidth[i] = sqft - windowSqFt[i];
+                hardwareSlopeWidth[i] = hardware - windowHardware[i];
+            }
         }
     }
 
-    void displayType() const override {
-        cout << "Random Design Fixed Window";
-        if (includeTee) cout << " (with Tee)";
-        cout << "\n";
-    }
+    void report(const CostRates& r, size_t topN = 10) const {
+        float keep = 1 - r.discountPercent / 100.0f;
+        float areaRate = r.glassRate + r.laborRate;
+        size_t n = windowAluminium.size(), profiles = profileNames.size();
 
-    float getArea() const override {
-        return 0.0f;  // Area doesn't apply for random fixed windows
+        vector<float> profileFeet(profiles, 0), profileCost(profiles, 0);
+        for (size_t i = 0; i < rowFeet.size(); ++i) {
+            profileFeet[rowProfile[i]] += rowFeet[i];
+            profileCost[rowProfile[i]] += rowCost[i];
+        }
+
+        float aluminium = 0, sqft = 0, hardware = 0;
+        vector<float> windowNet(n);
+        for (size_t i = 0; i < n; ++i) {
+            float kit = kitPriced ? windowHardware[i] : r.hardwareRate;
+            windowNet[i] = keep * windowAluminium[i] + areaRate * windowSqFt[i] + kit;
+            aluminium += windowAluminium[i];
+            sqft += windowSqFt[i];
+            hardware += kit;
+        }
+        float net = keep * aluminium + areaRate * sqft + hardware;
+
+        cout << fixed << setprecision(2);
+        cout << "\n=== Cost Sensitivity (" << r.name << ") ===\n";
+        cout << "Net Total: Rs. " << net << " for " << n << " window(s)\n";
+
+        cout << "\nRate sensitivities (Rs. of net total per Rs. 1 change in the rate):\n";
+        cout << left << setw(22) << "Rate" << right << setw(14) << "dNet/dRate" << setw(14) << "Cost" << setw(9) << "Share" << "\n";
+        auto share = [&](float cost) { return net > 0 ? 100 * cost / net : 0.0f; };
+
+        vector<int> byCost(profiles);
+        for (size_t p = 0; p < profiles; ++p) byCost[p] = static_cast<int>(p);
+        sort(byCost.begin(), byCost.end(), [&](int a, int b) { return profileCost[a] > profileCost[b]; });
+        for (int p : byCost) {
+            float cost = keep * profileCost[p];
+            cout << left << setw(22) << (profileNames[p] + " (Rs./ft)") << right << setw(14) << keep * profileFeet[p]
+                 << setw(14) << cost << setw(8) << share(cost) << "%\n";
+        }
+        cout << left << setw(22) << "Glass (Rs./sqft)" << right << setw(14) << sqft << setw(14) << r.glassRate * sqft
+             << setw(8) << share(r.glassRate * sqft) << "%\n";
+        cout << left << setw(22) << "Labor (Rs./sqft)" << right << setw(14) << sqft << setw(14) << r.laborRate * sqft
+             << setw(8) << share(r.laborRate * sqft) << "%\n";
+        if (kitPriced)  // no single rate: each window's kit is priced part by part
+            cout << left << setw(22) << "Hardware (kit prices)" << right << setw(14) << "n/a" << setw(14)
+                 << hardware << setw(8) << share(hardware) << "%\n";
+        else
+            cout << left << setw(22) << "Hardware (per window)" << right << setw(14) << static_cast<float>(n)
+                 << setw(14) << hardware << setw(8) << share(hardware) << "%\n";
+
+        cout << "\nDiscount: " << r.discountPercent << "% saves Rs. " << (1 - keep) * aluminium
+             << "; each further 1% saves Rs. " << aluminium / 100 << "\n";
+        cout << "Net Total without discount: Rs. " << net + (1 - keep) * aluminium << "\n";
+
+        size_t shown = min(topN, n);
+        vector<int> top(n);
+        for (size_t i = 0; i < n; ++i) top[i] = static_cast<int>(i);
+        partial_sort(top.begin(), top.begin() + shown, top.end(),
+                     [&](int a, int b) { return windowNet[a] > windowNet[b]; });
+
+        cout << "\nTop " << shown << " window(s) by net cost (Rs. per extra inch of height / width):\n";
+        cout << left << setw(48) << "Window" << right << setw(13) << "Net" << setw(9) << "Share"
+             << setw(11) << "dNet/dH" << setw(11) << "dNet/dW" << "\n";
+        for (size_t k = 0; k < shown; ++k) {
+            int i = top[k];
+            float dH = keep * slopeHeight[i] + areaRate * areaSlopeHeight[i] + hardwareSlopeHeight[i];
+            float dW = keep * slopeWidth[i] + areaRate * areaSlopeWidth[i] + hardwareSlopeWidth[i];
+            cout << left << setw(48) << windowLabels[i] << right << setw(13) << windowNet[i]
+                 << setw(8) << share(windowNet[i]) << "%";
+            if (hasHeightSlope[i]) cout << setw(11) << dH;
+            else cout << setw(11) << "n/a";
+            if (hasWidthSlope[i]) cout << setw(11) << dW;
+            else cout << setw(11) << "n/a";
+            cout << "\n";
+        }
     }
+};
 
-    map<string, float> getRequiredSections() const override {
-        map<string, float> sections;
-        float l = length, t = tee;
+// The built-in benchmarks add the seconds of the section they measure
+// here, the same figure they print, so wf_bench can time that alone and
+// leave out building the workload, checking and reporting.
+static double benchMeasuredSeconds = 0;
 
-        sections["D54"] = l;
-        if (includeTee) {
-            sections["D52"] = t;
-            sections["D41"] = l + (t * 2);
-        } else {
-            sections["D41"] = l;
-        }
+void addMeasuredSeconds(double seconds) { benchMeasuredSeconds += seconds; }
 
-        return sections;
-    }
+double takeMeasuredSeconds() {
+    double seconds = benchMeasuredSeconds;
+    benchMeasuredSeconds = 0;
+    return seconds;
+}
 
-    float calculateTotalPrice(const map<string, float>& rates) const override {
-        auto sections = getRequiredSections();
-        float total = 0;
+/////////////////////////////////////////////////////////
+// 🧪 Golden Regression Corpus & Differential Tester
+/////////////////////////////////////////////////////////
 
-        for (const auto& s : sections) {
-            float inches = s.second;
-            float feet = inches / 12.0f;
-            float roundedFeet = roundToMarketFeet(inches);
+class SectionRegression {
+public:
+    // A window's sections as a flat array sorted by code, so fast paths can
+    // be compared without building maps. Codes are the profile names packed
+    // into 64 bits (all of them are 8 characters or less).
+    struct FlatSections {
+        static constexpr int kMax = 16;
+        int count = 0;
+        uint64_t code[kMax];
+        float inches[kMax];
+
+        static uint64_t pack(const string& name) {
+            uint64_t c = 0;
+            for (size_t i = 0; i < 8; ++i) c = c << 8 | (i < name.size() ? static_cast<uint8_t>(name[i]) : 0);
+            return c;
+        }
 
-            float price = 0;
-            try {
-                price = roundedFeet * rates.at(s.first);
-            } catch (const std::out_of_range&) {
-                cout << "⚠️ Rate missing for section: " << s.first << "\n";
-                continue;
+        void add(const string& name, float length) {
+            uint64_t c = pack(name);
+            int i = 0;
+            while (i < count && code[i] < c) ++i;
+            if (i < count && code[i] == c) {
+                inches[i] += length;
+                return;
             }
+            if (count == kMax) return;
+            for (int j = count; j > i; --j) {
+                code[j] = code[j - 1];
+                inches[j] = inches[j - 1];
+            }
+            code[i] = c;
+            inches[i] = length;
+            ++count;
+        }
 
-            total += price;
-
-            cout << fixed << setprecision(2);
-            cout << s.first << ": " << inches << " inches = "
-                 << feet << " ft => rounded = " << roundedFeet
-                 << " => Rs. " << price << "\n";
+        bool matches(const FlatSections& o) const {
+            if (count != o.count) return false;
+            for (int i = 0; i < count; ++i)
+                if (code[i] != o.code[i] || fabs(inches[i] - o.inches[i]) > kTolerance) return false;
+            return true;
         }
+    };
 
-        return total;
+    // Fills out for a window that is already loaded; must not allocate per call.
+    using SectionsFn = void (*)(const FrameComponent& win, FlatSections& out);
+
+    // Formula changes below this (inches) are float noise, e.g. FMA contraction.
+    static constexpr float kTolerance = 0.001f;
+
+    // Alternative implementations (table driven, SIMD, fixed point...) register
+    // here and are compared against getRequiredSections() by fuzz().
+    static vector<pair<string, SectionsFn>>& fastPaths() {
+        static vector<pair<string, SectionsFn>> paths = {
+            { "cut pieces", cutPieceSections },
+        };
+        return paths;
     }
 
-private:
-    float roundToMarketFeet(float inches) const {
-        float ft = inches / 12.0f;
-        int whole = static_cast<int>(floor(ft));
-        float inch = (ft - whole) * 12;
-        return (inch <= 6.0f) ? (whole + 0.6f) : (whole + 1.0f);
+    // Cut pieces summed per profile must give back the section lengths.
+    static void cutPieceSections(const FrameComponent& win, FlatSections& out) {
+        thread_local vector<CutPiece> pieces;
+        pieces.clear();
+        win.getCutPieces(pieces);
+        for (const CutPiece& p : pieces) out.add(p.profile, p.length);
     }
-};
 
-/////////////////////////////////////////////////////////
-// 🪟 Openable window with or without net
-/////////////////////////////////////////////////////////
+    static int collarRange(int type) {
+        const WindowTypeInfo* info = ComponentRegistry::find(type);
+        return info ? info->collars : 1;
+    }
 
-class OpenableWindow : public FrameComponent {
-    float height = 0, width = 0;
-    int collerType = 1;
-    bool hasNet = false;
+    // Every collar / option combination of a type, dimensions left at zero.
+    static vector<WindowSpec> variants(int type) {
+        vector<WindowSpec> out;
+        for (int collar = 1; collar <= collarRange(type); ++collar) {
+            WindowSpec base;
+            base.type = type;
+            base.collar = collar;
+
+            switch (type) {
+                case 3:
+                    for (int net = 1; net <= 4; ++net) { base.netType = net; out.push_back(base); }
+                    break;
+                case 5: case 6: case 10:
+                    for (int tee = 0; tee <= 1; ++tee) { base.includeTee = tee; out.push_back(base); }
+                    break;
+                case 7:
+                    for (int net = 0; net <= 1; ++net) { base.hasNet = net; out.push_back(base); }
+                    break;
+                case 8: case 9:
+                    for (int d46 = 0; d46 <= 1; ++d46)
+                        for (int tee = 0; tee <= 1; ++tee) {
+                            base.includeD46 = d46;
+                            base.includeTee = tee;
+                            out.push_back(base);
+                        }
+                    break;
+                case 11: case 12:
+                    for (int coller = 0; coller <= 1; ++coller)
+                        for (int tee = 0; tee <= 1; ++tee)
+                            for (int shape = 0; shape <= (type == 11 ? 3 : 0); ++shape) {
+                                base.hasColler = coller;
+                                base.includeTee = tee;
+                                base.archShape = shape;
+                                out.push_back(base);
+                            }
+                    break;
+                case 13: case 14:
+                    for (int coller = 0; coller <= 1; ++coller) { base.hasColler = coller; out.push_back(base); }
+                    break;
+                case 15:  // roles only; fillDimensions() gives the widths
+                    for (const char* roles : { "F,F", "F,S", "S,F", "S,S", "F,S,F", "S,F,S", "F,F,F,F", "S,F,F,S,F,S" })
+                        for (int coller = 0; coller <= 1; ++coller)
+                            for (int tee = 0; tee <= (strchr(roles, 'S') ? 0 : 1); ++tee) {
+                                base.segments = roles;
+                                base.hasColler = coller;
+                                base.includeTee = tee;
+                                out.push_back(base);
+                            }
+                    break;
+                default:
+                    out.push_back(base);
+            }
+        }
+        return out;
+    }
 
-public:
-    void inputDimensions() override {
-        char netChoice;
-        cout << "Do you want net in this Openable Window? (y/n): ";
-        cin >> netChoice;
-        hasNet = (netChoice == 'y' || netChoice == 'Y');
+    // Fill in the dimensions an option actually uses.
+    static void fillDimensions(WindowSpec& s, float h, float w, float wr, float tee, float netWidth, float arch) {
+        s.height = h;
+        s.width = w;
+        if (s.type == 12 || s.type == 13 || s.type == 14) s.widthRight = wr;
+        if (s.includeTee) s.tee = tee;
+        if (s.netType == 3 || s.netType == 4 || ((s.type == 13 || s.type == 14) && s.collar == 4))
+            s.netWidth = netWidth;
+        if (s.type == 11 && s.archShape == 0) s.arch = arch;
+        if (s.type == 11 && s.archShape != 0) s.rise = min(arch, floor(w * 8) / 16);  // half span, to 1/16
+        if (s.type == 15) {  // bay roles get widths, alternating w and wr
+            vector<char> sliding;
+            if (BayWindow::parseRoles(s.segments, sliding)) {
+                vector<float> widths(sliding.size());
+                for (size_t i = 0; i < widths.size(); ++i) widths[i] = i % 2 ? wr : w;
+                s.segments = BayWindow::formatSegments(widths, sliding);
+            }
+        }
+    }
 
-        do {
-            cout << "Enter Coller Type (1 to 14): ";
-            cin >> collerType;
-        } while (collerType < 1 || collerType > 14);
+    static vector<WindowSpec> corpusSpecs() {
+        const float heights[] = { 12, 24.5f, 36, 47.75f, 60, 72.25f, 96 };
+        const float widths[] = { 12, 30.5f, 48, 59.75f, 84, 120 };
+        const float rightWidths[] = { 18, 36.5f };
+        const float arches[] = { 40.5f, 75 };
+
+        vector<WindowSpec> specs;
+        for (int type = 1; type <= ComponentRegistry::count(); ++type)
+            for (const WindowSpec& v : variants(type))
+                for (float h : heights)
+                    for (float w : widths)
+                        for (float wr : rightWidths)
+                            for (float arch : arches) {
+                                bool usesRight = (type == 12 || type == 13 || type == 14 || type == 15);
+                                if (!usesRight && wr != rightWidths[0]) continue;
+                                if (type != 11 && arch != arches[0]) continue;
+
+                                WindowSpec s = v;
+                                fillDimensions(s, h, w, wr, 20.25f, 22.5f, arch);
+                                specs.push_back(s);
+                            }
+        return specs;
+    }
 
-        do {
-            cout << "Enter height (in inches): ";
-            cin >> height;
-        } while (height <= 0);
+    static WindowSpec randomSpec(mt19937& rng) {
+        WindowSpec s;
+        randomSpec(rng, s);
+        return s;
+    }
 
-        do {
-            cout << "Enter width (in inches): ";
-            cin >> width;
-        } while (width <= 0);
+    // Into an existing spec, so the fuzzer reuses its string buffers.
+    static void randomSpec(mt19937& rng, WindowSpec& s) {
+        static const vector<WindowSpec> all = [] {
+            vector<WindowSpec> v;
+            for (int type = 1; type <= ComponentRegistry::count(); ++type)
+                for (const WindowSpec& s : variants(type)) v.push_back(s);
+            return v;
+        }();
+
+        // Sixteenths of an inch, like a tape measure.
+        uniform_int_distribution<int> pickVariant(0, static_cast<int>(all.size()) - 1);
+        uniform_int_distribution<int> sixteenths(6 * 16, 144 * 16);
+        auto len = [&] { return sixteenths(rng) / 16.0f; };
+
+        s = all[pickVariant(rng)];
+        fillDimensions(s, len(), len(), len(), len(), len(), len());
     }
 
-    void displayType() const override {
-        cout << "Openable Window (" << (hasNet ? "with Net" : "without Net") << ")\n";
+    static map<string, float> reference(const WindowSpec& spec) {
+        auto win = createComponent(spec.type);
+        win->loadSpec(spec);
+        return win->getRequiredSections();
     }
 
-    float getArea() const override {
-        return (height / 12.0f) * (width / 12.0f);
+    static bool sameSections(const map<string, float>& a, const map<string, float>& b) {
+        if (a.size() != b.size()) return false;
+        for (auto ia = a.begin(), ib = b.begin(); ia != a.end(); ++ia, ++ib) {
+            if (ia->first != ib->first || fabs(ia->second - ib->second) > kTolerance) return false;
+        }
+        return true;
     }
 
-    map<string, float> getRequiredSections() const override {
-        map<string, float> sections;
-        float h = height, w = width;
+    static string formatSections(const map<string, float>& sections) {
+        ostringstream out;
+        out << setprecision(9);
+        for (const auto& s : sections) out << ' ' << s.first << '=' << s.second;
+        return out.str();
+    }
 
-        // Coller based section formula
-        switch (collerType) {
-            case 1:  sections["D54F"] = (h + w) * 2 + 12; break;
-            case 2:  sections["D54A"] = (h + w) * 2; break;
-            case 3:  sections["D54F"] = (h * 2) + w + 9; sections["D54A"] = w; break;
-            case 4:  sections["D54F"] = (w * 2) + h + 9; sections["D54A"] = h; break;
-            case 5:  sections["D54F"] = (h * 2) + w + 9; sections["D54A"] = w; break;
-            case 6:  sections["D54F"] = (w * 2) + h + 9; sections["D54A"] = h; break;
-            case 7:  sections["D54F"] = h + w + 6; sections["D54A"] = h + w; break;
-            case 8:  sections["D54F"] = h + w + 6; sections["D54A"] = h + w; break;
-            case 9:  sections["D54F"] = (h * 2) + 6; sections["D54A"] = w * 2; break;
-            case 10: sections["D54F"] = (w * 2) + 6; sections["D54A"] = h * 2; break;
-            case 11: sections["D54F"] = w + 3; sections["D54A"] = (h * 2) + w; break;
-            case 12: sections["D54F"] = h * 3; sections["D54A"] = (w * 2) + h; break;
-            case 13: sections["D54F"] = w + 3; sections["D54A"] = (h * 2) + w; break;
-            case 14: sections["D54F"] = h + 3; sections["D54A"] = (w * 2) + h; break;
+    static bool writeGolden(const string& path) {
+        ofstream out(path);
+        if (!out) {
+            cerr << "❌ Error: Could not write " << path << "\n";
+            return false;
         }
 
-        // Net logic
-        sections["D50"] = (h + w) * 2;
-        if (hasNet) {
-            sections["D29"] = (h + w) * 2;
+        size_t count = 0;
+        for (const WindowSpec& spec : corpusSpecs()) {
+            out << formatSpec(spec) << " |" << formatSections(reference(spec)) << "\n";
+            ++count;
         }
-
-        return sections;
+        cout << "✅ Wrote " << count << " golden cases to " << path << "\n";
+        return true;
     }
 
-    float calculateTotalPrice(const map<string, float>& rates) const override {
-        auto sections = getRequiredSections();
-        float total = 0;
+    static bool checkGolden(const string& path) {
+        ifstream in(path);
+        if (!in) {
+            cerr << "❌ Error: Could not read " << path << "\n";
+            return false;
+        }
 
-        for (const auto& s : sections) {
-            if (!rates.count(s.first)) {
-                cerr << "❌ Error: Rate for section " << s.first << " not found!\n";
+        size_t cases = 0, failures = 0;
+        string line;
+        while (getline(in, line)) {
+            if (line.empty()) continue;
+
+            size_t bar = line.find('|');
+            istringstream specText(line.substr(0, bar));
+            WindowSpec spec;
+            if (bar == string::npos || !parseSpec(specText, spec)) {
+                cerr << "⚠️ Skipping malformed golden line: " << line << "\n";
                 continue;
             }
 
-            float inches = s.second;
-            float feet = inches / 12.0f;
-            float roundedFeet = roundToMarketFeet(inches);
-            float price = roundedFeet * rates.at(s.first);
-
-            total += price;
+            map<string, float> expected;
+            istringstream sectionText(line.substr(bar + 1));
+            string item;
+            while (sectionText >> item) {
+                size_t eq = item.find('=');
+                expected[item.substr(0, eq)] = stof(item.substr(eq + 1));
+            }
 
-            cout << fixed << setprecision(2);
-            cout << s.first << ": " << inches << " in = " << feet << " ft => rounded = "
-                 << roundedFeet << " ft => Rs. " << price << "\n";
+            ++cases;
+            map<string, float> actual = reference(spec);
+            if (!sameSections(expected, actual)) {
+                if (++failures <= 20)
+                    cout << "❌ " << formatSpec(spec) << "\n   expected:" << formatSections(expected)
+                         << "\n   actual:  " << formatSections(actual) << "\n";
+            }
         }
 
-        return total;
+        cout << (failures ? "❌ " : "✅ ") << cases - failures << "/" << cases
+             << " golden cases match.\n";
+        return failures == 0;
     }
 
-private:
-    float roundToMarketFeet(float inches) const {
-        float ft = inches / 12.0f;
-        int whole = static_cast<int>(floor(ft));
-        float inch = (ft - whole) * 12;
-
-        return (inch <= 6.0f) ? (whole + 0.6f) : (whole + 1.0f);
+    // Random specs against the reference, one RNG and one window per type per
+    // thread so nothing is allocated or shared in the loop.
+    static bool fuzz(long long cases, unsigned threads) {
+        if (threads == 0) threads = 1;
+        const auto& paths = fastPaths();
+        if (paths.empty())
+            cout << "ℹ️ No fast paths registered; measuring the reference alone.\n";
+
+        atomic<long long> failures{0};
+        mutex reportLock;
+        auto start = chrono::steady_clock::now();
+
+        vector<thread> workers;
+        for (unsigned t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                mt19937 rng(12345u + t);
+                vector<unique_ptr<FrameComponent>> windows(ComponentRegistry::count() + 1);
+                for (int type = 1; type <= ComponentRegistry::count(); ++type) windows[type] = createComponent(type);
+
+                long long mine = cases / threads + (t < cases % threads ? 1 : 0);
+                WindowSpec spec;
+                for (long long i = 0; i < mine; ++i) {
+                    randomSpec(rng, spec);
+                    FrameComponent& win = *windows[spec.type];
+                    win.loadSpec(spec);
+                    FlatSections expected;
+                    for (const auto& sec : win.requiredSections()) expected.add(sec.first, sec.second);
+
+                    for (const auto& path : paths) {
+                        FlatSections actual;
+                        path.second(win, actual);
+                        if (expected.matches(actual)) continue;
+
+                        if (++failures <= 20) {
+                            lock_guard<mutex> lock(reportLock);
+                            cout << "❌ " << path.first << " differs for " << formatSpec(spec)
+                                 << "\n   expected:" << formatSections(reference(spec)) << "\n   actual:  ";
+                            for (int k = 0; k < actual.count; ++k) {
+                                string code;
+                                for (int b = 7; b >= 0; --b)
+                                    if (char c = static_cast<char>(actual.code[k] >> (8 * b))) code += c;
+                                cout << ' ' << code << '=' << actual.inches[k];
+                            }
+                            cout << "\n";
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        addMeasuredSeconds(seconds);
+        cout << fixed << setprecision(2)
+             << (failures ? "❌ " : "✅ ") << cases << " random cases, " << paths.size()
+             << " fast path(s), " << failures.load() << " mismatch(es) in " << seconds << " s ("
+             << (seconds > 0 ? cases / seconds / 1e6 : 0.0) << " M cases/s on " << threads << " thread(s))\n";
+        return failures == 0;
     }
 };
 
 /////////////////////////////////////////////////////////
-// 🪟 Door/Double Door with Divider and Tee or Not
+// 📥 Mixed-type Project Import (parallel parse / validate / price)
 /////////////////////////////////////////////////////////
 
-class DoorWindow : public FrameComponent {
-    float height = 0, width = 0, tee = 0;
-    int collerType = 1;
-    bool includeD46 = false;
-    bool includeTee = false;
-    bool isDouble = false; // 👈 New flag
+// Split [0, count) into one contiguous chunk per worker thread and run
+// fn(begin, end, worker) on each. Chunks keep input order.
+template <class Fn>
+void parallelFor(size_t count, unsigned workers, Fn fn) {
+    workers = max(1u, workers);
+    if (workers == 1 || count < 2) {
+        fn(size_t(0), count, 0u);
+        return;
+    }
+
+    size_t chunk = (count + workers - 1) / workers;
+    vector<thread> threads;
+    for (unsigned t = 0; t < workers; ++t) {
+        size_t begin = min(count, t * chunk), end = min(count, begin + chunk);
+        threads.emplace_back([=, &fn] { fn(begin, end, t); });
+    }
+    for (auto& th : threads) th.join();
+}
 
+// One window (or qty identical windows) per line, key=value pairs:
+//     type=5 qty=2 tag=GF collar=3 h=48 w=60 tee=20
+// Keys: type qty tag collar (or subtype) net netwidth tee hasnet d46 coller
+//       h w (or length) wr arch shape rise segments units. '#' starts a
+//       comment line. Bay windows take segments=F36,S48,F36 (role, width).
+// Sizes may carry a unit (h=1200mm w=5'3-1/2"); units=mm sets it for the
+// bare sizes after it on the line.
+//
+// A survey sheet saved as CSV works too: a header row of the same keys,
+// then one row per window. Cells may be quoted (5'3 1/2" is "5'3 1/2""")
+// and a units column sets the default unit of each row.
+class ProjectImporter {
 public:
-    DoorWindow(bool doubleDoor = false) : isDouble(doubleDoor) {}
+    static constexpr int kMaxQty = 10000;  // per line
 
-    void inputDimensions() override {
-        char ans;
-        cout << "Do you want to include bottom section D46? (y/n): ";
-        cin >> ans;
-        includeD46 = (ans == 'y' || ans == 'Y');
+    struct Item {
+        WindowSpec spec;
+        string tag = "-";
+        int qty = 1;
+    };
+
+    static bool parseNumber(const string& text, float& value) {
+        auto result = from_chars(text.data(), text.data() + text.size(), value);
+        if (result.ec == errc() && result.ptr == text.data() + text.size()) return true;
+        char* end = nullptr;  // leading '+', spaces, hex: slower but same as before
+        value = strtof(text.c_str(), &end);
+        return end != text.c_str() && *end == '\0';
+    }
+
+    static bool parseFlag(const string& text) {
+        return text == "1" || text == "y" || text == "Y" || text == "yes";
+    }
+
+    // Keys that hold a size in inches, and so accept a unit.
+    static bool setDimension(WindowSpec& s, const string& key, float inches) {
+        if      (key == "h")                    s.height = inches;
+        else if (key == "w" || key == "length") s.width = inches;
+        else if (key == "wr")                   s.widthRight = inches;
+        else if (key == "tee")                  { s.tee = inches; s.includeTee = inches > 0; }
+        else if (key == "netwidth")             s.netWidth = inches;
+        else if (key == "arch")                 s.arch = inches;
+        else if (key == "rise")                 s.rise = inches;
+        else return false;
+        return true;
+    }
+
+    static bool isDimension(const string& key) {
+        WindowSpec scratch;
+        return setDimension(scratch, key, 0);
+    }
+
+    // Integer keys take whole numbers in [lo, hi] only; anything else would
+    // be truncated or overflow the cast.
+    static string setWhole(int& field, const string& key, const string& text, float v, int lo, int hi) {
+        if (v != floor(v)) return key + " must be a whole number, got '" + text + "'";
+        if (v < lo || v > hi) return key + " must be " + to_string(lo) + " to " + to_string(hi) + ", got '" + text + "'";
+        field = static_cast<int>(v);
+        return "";
+    }
+
+    // Every other key; returns an error message, or "" when it was set.
+    static string setField(Item& item, const string& key, const string& text, Units::Unit unit = Units::Inch) {
+        WindowSpec& s = item.spec;
+        if (key == "tag") { item.tag = text; return ""; }
+        if (key == "segments") {  // kept in inches from here on
+            vector<float> widths;
+            vector<char> sliding;
+            if (!BayWindow::parseSegments(text, widths, sliding, unit))
+                return "bad segments: '" + text + "' (2 to " + to_string(BayWindow::kMaxSegments) +
+                       " widths above 0, e.g. F36,S48,F36)";
+            s.segments = BayWindow::formatSegments(widths, sliding);
+            s.width = 0;
+            for (float w : widths) s.width += w;
+            return "";
+        }
+        if (key == "hasnet") { s.hasNet = parseFlag(text); return ""; }
+        if (key == "d46") { s.includeD46 = parseFlag(text); return ""; }
+        if (key == "coller") { s.hasColler = parseFlag(text); return ""; }
+
+        float v = 0;
+        bool numeric = parseNumber(text, v);
+        if (key == "type" && !numeric) {
+            const WindowTypeInfo* info = ComponentRegistry::find(text);
+            if (!info) return "unknown window type '" + text + "'";
+            s.type = info->id;
+            return "";
+        }
+        if (!numeric) return "bad number for " + key + ": '" + text + "'";
+
+        // Per-type limits (collar, net) are checked once the line is complete.
+        if      (key == "type")                       return setWhole(s.type, key, text, v, 1, ComponentRegistry::count());
+        else if (key == "qty")                        return setWhole(item.qty, key, text, v, 1, kMaxQty);
+        else if (key == "collar" || key == "subtype") return setWhole(s.collar, key, text, v, 0, 99);
+        else if (key == "net")                        return setWhole(s.netType, key, text, v, 0, 99);
+        else if (key == "shape")                      return setWhole(s.archShape, key, text, v, 0, 3);
+        return "unknown key '" + key + "'";
+    }
+
+    static string parseLine(const string& line, Item& item) {
+        istringstream fields(line);
+        string field;
+        Units::Unit unit = Units::Inch;
 
-        cout << "Do you want to include a Tee (divider)? (y/n): ";
-        cin >> ans;
-        includeTee = (ans == 'y' || ans == 'Y');
+        while (fields >> field) {
+            size_t eq = field.find('=');
+            if (eq == string::npos) return "expected key=value, got '" + field + "'";
 
-        if (includeTee) {
-            do {
-                cout << "Enter Tee length (in inches): ";
-                cin >> tee;
-            } while (tee <= 0);
+            string key = field.substr(0, eq), text = field.substr(eq + 1);
+            if (key == "units") {
+                if (!Units::unitFromName(text, unit)) return "unknown unit '" + text + "'";
+                continue;
+            }
+            if (isDimension(key)) {
+                float inches;
+                if (!Units::parse(text, inches, unit)) return "bad size for " + key + ": '" + text + "'";
+                setDimension(item.spec, key, inches);
+                continue;
+            }
+            string error = setField(item, key, text, unit);
+            if (!error.empty()) return error;
         }
 
-        do {
-            cout << "Enter collar type (1–8): ";
-            cin >> collerType;
-        } while (collerType < 1 || collerType > 8);
+        return validate(item);
+    }
 
-        do {
-            cout << "Enter height (in inches): ";
-            cin >> height;
-        } while (height <= 0);
+    // Same limits the interactive prompts enforce, plus the type's size range.
+    // Which fields are required follows the type's inputs; anything more is
+    // the type's own check.
+    static string validate(const Item& item) {
+        const WindowSpec& s = item.spec;
+        const WindowTypeInfo* info = ComponentRegistry::find(s.type);
+        if (!info)
+            return "window type must be 1 to " + to_string(ComponentRegistry::count());
+        if (item.qty < 1) return "quantity must be at least 1";
+
+        if (info->collars > 1 && (s.collar < 1 || s.collar > info->collars))
+            return "collar/subtype must be 1 to " + to_string(info->collars);
+
+        const char* widthKey = info->uses("length") ? "length" : info->uses("w") ? "w" : nullptr;
+        bool shaped = info->uses("shape") && s.archShape != 0;  // the top is drawn from w and rise
+        bool needsHeight = info->uses("h") && !shaped;
+        if (widthKey && s.width <= 0) return "width must be greater than 0";
+        if (needsHeight && s.height <= 0) return "height must be greater than 0";
+        if (info->uses("wr") && s.widthRight <= 0) return "wr must be greater than 0";
+        if (info->uses("net")) {
+            if (s.netType < 1 || s.netType > 4) return "net type must be 1 to 4";
+            if (s.netType >= 3 && s.netWidth <= 0) return "netwidth must be greater than 0";
+        }
+        if (info->check) {
+            string error = info->check(s);
+            if (!error.empty()) return error;
+        }
+        if (info->uses("segments")) {  // each segment is checked on its own, not the whole run
+            vector<float> widths;
+            vector<char> sliding;
+            if (!BayWindow::parseSegments(s.segments, widths, sliding))
+                return "segments must list 2 to " + to_string(BayWindow::kMaxSegments) + " widths, e.g. F36,S48,F36";
+            for (size_t i = 0; i < widths.size(); ++i) {
+                string error = info->checkSize(("segment " + to_string(i + 1)).c_str(), widths[i]);
+                if (!error.empty()) return error;
+            }
+            return info->checkSize("h", s.height);
+        }
 
-        do {
-            cout << "Enter width (in inches): ";
-            cin >> width;
-        } while (width <= 0);
+        string error = widthKey ? info->checkSize(widthKey, s.width) : "";
+        if (error.empty() && s.height > 0) error = info->checkSize("h", s.height);
+        if (error.empty() && info->uses("wr")) error = info->checkSize("wr", s.widthRight);
+        return error;
     }
 
-    void displayType() const override {
-        cout << (isDouble ? "🚪 Double Door\n" : "🚪 Single Door\n");
+    // Splits one CSV row; "" inside a quoted cell is a literal quote.
+    static vector<string> splitCsv(const string& line) {
+        vector<string> cells;
+        cells.reserve(count(line.begin(), line.end(), ',') + 1);
+        cells.emplace_back();
+        bool quoted = false;
+        for (size_t i = 0; i < line.size();) {
+            // Copy the run up to the next character that matters in one go.
+            size_t stop = quoted ? line.find('"', i) : line.find_first_of(",\"\r", i);
+            if (stop == string::npos) stop = line.size();
+            cells.back().append(line, i, stop - i);
+            if (stop == line.size()) break;
+
+            char c = line[stop];
+            i = stop + 1;
+            if (quoted) {
+                if (i < line.size() && line[i] == '"') { cells.back() += '"'; ++i; }
+                else quoted = false;
+            } else if (c == '"') {
+                quoted = true;
+            } else if (c == ',') {
+                cells.emplace_back();
+            }
+        }
+        return cells;
     }
 
-    float getArea() const override {
-        return (height / 12.0f) * (width / 12.0f);
+    static bool skipLine(const string& line) {
+        return line.find_first_not_of(" \t\r,") == string::npos || line[0] == '#';
     }
 
-    map<string, float> getRequiredSections() const override {
-        map<string, float> sections;
-        float h = height, w = width, t = tee;
-
-        // D54F and D54A
-        switch (collerType) {
-            case 1: sections["D54F"] = (h * 2) + w + 9;                        break;
-            case 2: sections["D54A"] = (h * 2) + w;                            break;
-            case 3: sections["D54F"] = h + w + 6;   sections["D54A"] = h;     break;
-            case 4: sections["D54F"] = (h * 2) + 6; sections["D54A"] = w;     break;
-            case 5: sections["D54F"] = h + w + 6;   sections["D54A"] = h;     break;
-            case 6: sections["D54F"] = h + 3;       sections["D54A"] = h + w; break;
-            case 7: sections["D54F"] = h + 3;       sections["D54A"] = h + w; break;
-            case 8: sections["D54F"] = w + 3;       sections["D54A"] = h * 2; break;
+    // Reads a project file or survey CSV into validated items, in file
+    // order. Bad lines go to errors as "line N: message".
+    static bool readItems(const string& path, vector<Item>& items, vector<string>& errors) {
+        string text;
+        if (!SessionJournal::get().readFile(path, text)) {
+            cerr << "❌ Error: Could not read " << path << "\n";
+            return false;
         }
-
-        // D50 and D46 logic updated for double door
-        if (includeD46) {
-            sections["D46"] = w;
-            sections["D50"] = isDouble ? (h * 4) + w : (h * 2) + w;
+        istringstream in(text);
+
+        vector<string> lines;
+        for (string line; getline(in, line);) lines.push_back(move(line));
+
+        size_t first = 0;
+        while (first < lines.size() && skipLine(lines[first])) ++first;
+        bool csv = first < lines.size() && lines[first].find(',') != string::npos
+                   && lines[first].find('=') == string::npos;
+
+        vector<Item> parsed(lines.size());
+        vector<string> lineError(lines.size());
+        vector<char> used(lines.size(), 0);
+        unsigned workers = max(1u, thread::hardware_concurrency());
+
+        if (!csv) {
+            parallelFor(lines.size(), workers, [&](size_t begin, size_t end, unsigned) {
+                for (size_t i = begin; i < end; ++i) {
+                    if (skipLine(lines[i])) continue;
+                    used[i] = 1;
+                    lineError[i] = parseLine(lines[i], parsed[i]);
+                }
+            });
         } else {
-            sections["D50"] = isDouble ? (h * 4) + (w * 2) : (h + w) * 2;
+            readCsv(lines, first, workers, parsed, lineError, used);
         }
 
-        // Optional Tee
-        if (includeTee) {
-            sections["D52"] = t;
+        for (size_t i = 0; i < lines.size(); ++i) {
+            if (!used[i]) continue;
+            if (!lineError[i].empty()) errors.push_back("line " + to_string(i + 1) + ": " + lineError[i]);
+            else items.push_back(move(parsed[i]));
         }
+        return true;
+    }
 
-        return sections;
+    // Column at a time: every size cell is split into number and unit on
+    // all cores, each size column is scaled to inches with one
+    // Units::toInches() call, then the rows are assembled and validated.
+    static void readCsv(const vector<string>& lines, size_t header, unsigned workers, vector<Item>& parsed,
+                        vector<string>& lineError, vector<char>& used) {
+        vector<string> keys = splitCsv(lines[header]);
+        int unitsColumn = -1;
+        vector<int> sizeColumns;
+        vector<char> fieldColumn(keys.size(), 0);  // set through setField()
+        for (size_t c = 0; c < keys.size(); ++c) {
+            string& key = keys[c];
+            key.erase(0, key.find_first_not_of(" \t"));
+            key.erase(key.find_last_not_of(" \t") + 1);
+            for (char& ch : key) ch = static_cast<char>(tolower(static_cast<unsigned char>(ch)));
+
+            Item probe;
+            if (key == "units") unitsColumn = static_cast<int>(c);
+            else if (isDimension(key)) sizeColumns.push_back(static_cast<int>(c));
+            else if (setField(probe, key, "0").rfind("unknown key", 0) == 0) {
+                used[header] = 1;
+                lineError[header] = "unknown column '" + key + "'";
+                return;
+            } else fieldColumn[c] = 1;
+        }
+
+        size_t n = lines.size();
+        vector<vector<string>> rows(n);
+        size_t columns = sizeColumns.size();
+        vector<float> value(columns * n, 0.0f);           // column-major
+        vector<Units::Unit> unit(columns * n, Units::Inch);
+        vector<char> present(columns * n, 0);
+
+        parallelFor(n, workers, [&](size_t begin, size_t end, unsigned) {
+            for (size_t i = max(begin, header + 1); i < end; ++i) {
+                if (skipLine(lines[i])) continue;
+                used[i] = 1;
+                rows[i] = splitCsv(lines[i]);
+                rows[i].resize(keys.size());
+
+                Units::Unit rowUnit = Units::Inch;
+                if (unitsColumn >= 0 && !Units::unitFromName(rows[i][unitsColumn], rowUnit)) {
+                    lineError[i] = "unknown unit '" + rows[i][unitsColumn] + "'";
+                    continue;
+                }
+                for (size_t k = 0; k < columns && lineError[i].empty(); ++k) {
+                    const string& cell = rows[i][sizeColumns[k]];
+                    if (cell.find_first_not_of(" \t") == string::npos) continue;
+                    size_t at = k * n + i;
+                    if (Units::split(cell, value[at], unit[at], rowUnit)) present[at] = 1;
+                    else lineError[i] = "bad size for " + keys[sizeColumns[k]] + ": '" + cell + "'";
+                }
+            }
+        });
+
+        for (size_t k = 0; k < columns; ++k)
+            Units::toInches(&value[k * n], &unit[k * n], &value[k * n], n);
+
+        parallelFor(n, workers, [&](size_t begin, size_t end, unsigned) {
+            for (size_t i = max(begin, header + 1); i < end; ++i) {
+                if (!used[i] || !lineError[i].empty()) continue;
+                Item& item = parsed[i];
+                Units::Unit rowUnit = Units::Inch;
+                if (unitsColumn >= 0) Units::unitFromName(rows[i][unitsColumn], rowUnit);
+                for (size_t c = 0; c < keys.size() && lineError[i].empty(); ++c) {
+                    const string& cell = rows[i][c];
+                    if (!fieldColumn[c] || cell.find_first_not_of(" \t") == string::npos) continue;
+                    lineError[i] = setField(item, keys[c], cell, rowUnit);
+                }
+                for (size_t k = 0; k < columns; ++k)
+                    if (present[k * n + i]) setDimension(item.spec, keys[sizeColumns[k]], value[k * n + i]);
+                if (lineError[i].empty()) lineError[i] = validate(item);
+            }
+        });
     }
 
-    float calculateTotalPrice(const map<string, float>& rates) const override {
-        auto sections = getRequiredSections();
-        float total = 0;
+    // Writes an N-row survey CSV with sizes in mixed units, then times
+    // readItems() on it.
+    static void benchmark(size_t rows);
+
+    // Parse, validate and build windows on all cores, group them by type,
+    // ask for the union of missing rates once, then price in parallel.
+    // The priced windows are kept packed in store, not as objects.
+    static bool importFile(const string& path, const PriceBook& priceBook, QuoteCache& cache, PackedWindowStore& store,
+                           vector<QuoteEntry>& windows, float& totalAluminium, float& totalSqFt) {
+        vector<Item> parsedItems;
+        vector<string> errors;
+        if (!readItems(path, parsedItems, errors)) return false;
+
+        // Window objects exist only while a worker needs one; what is kept
+        // is the spec, packed at the end.
+        struct Built {
+            QuoteEntry entry;
+            const WindowSpec* spec = nullptr;
+            float price = 0, area = 0;
+        };
 
-        for (const auto& s : sections) {
-            float inches = s.second;
-            float feet = inches / 12.0f;
-            float roundedFeet = roundToMarketFeet(inches);
-            float price = roundedFeet * rates.at(s.first);
-            total += price;
+        unsigned workers = max(1u, thread::hardware_concurrency());
+        vector<vector<Built>> built(workers);
+        vector<set<string>> needed(workers);
+
+        // Stage 1: validated spec -> sections needed and area.
+        parallelFor(parsedItems.size(), workers, [&](size_t begin, size_t end, unsigned t) {
+            for (size_t i = begin; i < end; ++i) {
+                const Item& item = parsedItems[i];
+                auto win = createComponent(item.spec.type);
+                win->loadSpec(item.spec);
+                for (const auto& sec : win->requiredSections()) needed[t].insert(sec.first);
+                for (int n = 0; n < item.qty; ++n) {
+                    Built b;
+                    b.entry.type = item.spec.type;
+                    b.entry.tag = item.tag;
+                    b.spec = &item.spec;
+                    b.area = win->getArea();
+                    built[t].push_back(move(b));
+                }
+            }
+        });
+
+        size_t errorCount = 0;
+        for (const auto& e : errors)
+            if (++errorCount <= 20) cout << "⚠️ Skipped " << e << "\n";
+        if (errorCount > 20) cout << "⚠️ ... and " << errorCount - 20 << " more invalid line(s)\n";
+
+        // Group by type, keeping file order inside each type.
+        vector<Built> items;
+        for (int type = 1; type <= ComponentRegistry::count(); ++type)
+            for (auto& list : built)
+                for (auto& b : list)
+                    if (b.entry.type == type) items.push_back(move(b));
+
+        if (items.empty()) {
+            cout << "⚠️ No valid windows in " << path << "\n";
+            return false;
+        }
 
-            cout << fixed << setprecision(2);
-            cout << s.first << ": " << inches << " inches = " << feet
-                 << " ft => rounded ft = " << roundedFeet
-                 << " => Rs. " << price << "\n";
+        // Stage 2: one rate per section for the whole project.
+        set<string> allSections;
+        for (const auto& list : needed) allSections.insert(list.begin(), list.end());
+        auto rates = make_shared<const RateTable>(collectRates(allSections, priceBook));
+
+        // Stage 3: price every window, same result as calculateTotalPrice.
+        // Sizes already in the quote cache are copied; each distinct miss is
+        // priced once, on all cores, and stored.
+        auto build = [&](size_t i) {
+            auto win = createComponent(items[i].entry.type);
+            win->loadSpec(*items[i].spec);
+            return win;
+        };
+        vector<string> keys(items.size());
+        parallelFor(items.size(), workers, [&](size_t begin, size_t end, unsigned) {
+            for (size_t i = begin; i < end; ++i) {
+                auto win = build(i);
+                WindowSpec spec = win->getSpec();
+                spec.type = items[i].entry.type;
+                keys[i] = QuoteCache::keyText(spec, *win, *rates);
+            }
+        });
+
+        vector<size_t> source(items.size());   // item whose quote this one copies
+        vector<size_t> fresh;                   // items priced here
+        vector<QuoteCache::Quote> quotes(items.size());
+        unordered_map<string, size_t> firstMiss;
+        for (size_t i = 0; i < items.size(); ++i) {
+            source[i] = i;
+            auto seen = firstMiss.find(keys[i]);
+            if (seen != firstMiss.end()) source[i] = seen->second;
+            else if (!cache.get(keys[i], quotes[i])) {
+                firstMiss.emplace(keys[i], i);
+                fresh.push_back(i);
+            }
         }
 
-        return total;
-    }
+        parallelFor(fresh.size(), workers, [&](size_t begin, size_t end, unsigned) {
+            for (size_t f = begin; f < end; ++f)
+                quotes[fresh[f]] = QuoteCache::quote(*build(fresh[f]), *rates);
+        });
+        for (size_t i : fresh) cache.put(keys[i], quotes[i]);
+        for (size_t i = 0; i < items.size(); ++i) items[i].price = quotes[source[i]].total;
+        cache.save();
+        cache.printStats();
+
+        map<int, pair<int, float>> perType;  // type -> (count, aluminium)
+        float importedAluminium = 0;
+        for (auto& b : items) {
+            auto& row = perType[b.entry.type];
+            row.first++;
+            row.second += b.price;
+            importedAluminium += b.price;
+            totalSqFt += b.area;
+
+            b.entry.rates = rates;
+            b.entry.pack(store, *b.spec);
+            windows.push_back(move(b.entry));
+        }
+        totalAluminium += importedAluminium;
 
-private:
-    float roundToMarketFeet(float inches) const {
-        float ft = inches / 12.0f;
-        int whole = static_cast<int>(floor(ft));
-        float inch = (ft - whole) * 12;
-        return (inch <= 6.0f) ? whole + 0.6f : whole + 1.0f;
+        cout << fixed << setprecision(2) << "\n--- Imported " << items.size() << " window(s) ---\n";
+        for (const auto& row : perType)
+            cout << windowTypeName(row.first) << ": " << row.second.first << " => Rs. " << row.second.second << "\n";
+        cout << "Aluminium for this import: Rs. " << importedAluminium << "\n";
+        return true;
     }
 };
 
 /////////////////////////////////////////////////////////
-// 🪟 Qadial Arch Window
+// 🏭 Fabrication Time Estimator & Shop-floor Scheduler
 /////////////////////////////////////////////////////////
 
-class QadialArchWindow : public FrameComponent {
-    float height = 0, width = 0, T = 0;
-    int collerType = 1;
-    bool includeTee = false;
+struct ShopConfig {
+    int machines[kStationCount] = { 1, 2, 1 };  // saws, benches, glazing tables
+    float hoursPerDay = 8.0f;
+    float labourRatePerHour = 0.0f;
+    FabTimes times;
+    vector<float> meshRolls = { 36, 48 };  // mesh roll widths, inches
+    float meshRollLength = 1181.0f;         // 30 m rolls
+    float meshAllowance = 1.0f;             // mesh tucked into the D29 channel, per side
+
+    // "key value" lines, '#' for comments. Unknown keys are reported.
+    static ShopConfig load(const string& path = "shop.cfg") {
+        ShopConfig c;
+        string text;
+        SessionJournal::get().readFile(path, text);
+        istringstream in(text);
+        string key;
+        float value;
+        bool customRolls = false;
+
+        while (in >> key) {
+            if (key[0] == '#') { in.ignore(10000, '\n'); continue; }
+            if (!(in >> value)) break;
+
+            if      (key == "saws")                 c.machines[0] = max(1, static_cast<int>(value));
+            else if (key == "benches")              c.machines[1] = max(1, static_cast<int>(value));
+            else if (key == "glaziers")             c.machines[2] = max(1, static_cast<int>(value));
+            else if (key == "hours_per_day")        c.hoursPerDay = value;
+            else if (key == "labour_rate_per_hour") c.labourRatePerHour = value;
+            else if (key == "cut_setup")            c.times.cutSetup = value;
+            else if (key == "per_cut")              c.times.perCut = value;
+            else if (key == "per_joint")            c.times.perJoint = value;
+            else if (key == "tee_fix")              c.times.teeFix = value;
+            else if (key == "net_fit")              c.times.netFit = value;
+            else if (key == "sash")                 c.times.sash = value;
+            else if (key == "glass_base")           c.times.glassBase = value;
+            else if (key == "glass_per_sqft")       c.times.glassPerSqFt = value;
+            else if (key == "mesh_roll" && value > 0) {  // repeat for each width stocked
+                if (!customRolls) c.meshRolls.clear();
+                customRolls = true;
+                c.meshRolls.push_back(value);
+            }
+            else if (key == "mesh_roll_length")     c.meshRollLength = max(1.0f, value);
+            else if (key == "mesh_allowance")       c.meshAllowance = max(0.0f, value);
+            else cerr << "⚠️ Unknown key in " << path << ": " << key << "\n";
+        }
 
+        return c;
+    }
+};
+
+class ShopScheduler {
 public:
-    void inputDimensions() override {
-        do {
-            cout << "Enter Coller Type (1 to 8): ";
-            cin >> collerType;
-        } while (collerType < 1 || collerType > 8);
+    struct Slot {
+        int window;
+        int machine;
+        string operation;
+        float start, end;  // minutes from the start of the order
+    };
 
-        do {
-            cout << "Enter height (in inches): ";
-            cin >> height;
-        } while (height <= 0);
+private:
+    ShopConfig config;
+    vector<Slot> slots;
+    float makespan = 0;
+    float busy[kStationCount] = {};
+
+    int firstMachine(int station) const {
+        int first = 0;
+        for (int i = 0; i < station; ++i) first += config.machines[i];
+        return first;
+    }
 
-        do {
-            cout << "Enter width (in inches): ";
-            cin >> width;
-        } while (width <= 0);
+    int machineCount() const { return firstMachine(kStationCount); }
 
-        cout << "Do you want to include Tee/Divider (1 = Yes, 0 = No)? ";
-        cin >> includeTee;
-        if (includeTee) {
-            do {
-                cout << "Enter Tee (Divider) length in inches: ";
-                cin >> T;
-            } while (T <= 0);
-        }
+    string machineName(int machine) const {
+        static const char* const names[kStationCount] = { "Saw", "Bench", "Glazing" };
+        int station = 0;
+        while (machine >= firstMachine(station + 1)) ++station;
+        return string(names[station]) + " " + to_string(machine - firstMachine(station) + 1);
     }
 
-    void displayType() const override {
-        cout << "Qadial Arch (4-corner) Window\n";
-    }
+public:
+    explicit ShopScheduler(ShopConfig c = ShopConfig::load()) : config(c) {}
+
+    // List scheduling in order entry: each operation goes to the machine of
+    // its station that frees up first, after the window's previous stage.
+    // Cuts of one window may run on several saws at once; bench work and
+    // glazing follow each other on the same frame.
+    void schedule(const vector<const FrameComponent*>& windows) {
+        using Free = pair<float, int>;  // (free at, machine)
+        priority_queue<Free, vector<Free>, greater<Free>> free[kStationCount];
+        for (int st = 0; st < kStationCount; ++st)
+            for (int m = 0; m < config.machines[st]; ++m) free[st].push({ 0.0f, firstMachine(st) + m });
+
+        slots.clear();
+        makespan = 0;
+        for (float& b : busy) b = 0;
+
+        for (size_t w = 0; w < windows.size(); ++w) {
+            vector<FabOperation> ops = windows[w]->getOperations(config.times);
+            float stageReady = 0, stageDone = 0;
+            Station stage = Station::Saw;
+
+            for (auto& op : ops) {
+                if (op.station != stage) {  // next stage waits for the whole previous one
+                    stage = op.station;
+                    stageReady = stageDone;
+                }
 
-    float getArea() const override {
-        return (height / 12.0f) * (width / 12.0f); // Area in sq ft
-    }
+                int st = static_cast<int>(op.station);
+                Free m = free[st].top();
+                free[st].pop();
 
-    map<string, float> getRequiredSections() const override {
-        map<string, float> sections;
-        float h = height, w = width;
+                float start = max(m.first, stageReady);
+                float end = start + op.minutes;
+                free[st].push({ end, m.second });
 
-        switch (collerType) {
-            case 1: sections["D50F"] = (h * 2) + w + 9; sections["D50A"] = w; break;
-            case 2: sections["D50A"] = (h + w) * 2; break;
-            case 3: sections["D50F"] = w + h + 6; sections["D50A"] = w + h; break;
-            case 4: sections["D50F"] = (h * 2) + 6; sections["D50A"] = w * 2; break;
-            case 5: sections["D50F"] = w + h + 6; sections["D50A"] = w; break;
-            case 6: sections["D50F"] = w + 3; sections["D50A"] = (h * 3) + w; break;
-            case 7: sections["D50F"] = h + 3; sections["D50A"] = (w * 2) + h; break;
-            case 8: sections["D50F"] = h + 3; sections["D50A"] = (w * 2) + h; break;
+                if (op.station != Station::Saw) stageReady = end;  // same frame, one step at a time
+                stageDone = max(stageDone, end);
+                busy[st] += op.minutes;
+                makespan = max(makespan, end);
+                slots.push_back({ static_cast<int>(w), m.second, move(op.name), start, end });
+            }
         }
+    }
 
-        // Handle optional Tee
-        if (includeTee) {
-            sections["D40"] = T;
-            sections["D41"] = ((h + w) * 2) + (T * 2);
-        } else {
-            sections["D41"] = (h + w) * 2;
+    float makespanMinutes() const { return makespan; }
+    size_t operationCount() const { return slots.size(); }
+
+    void printSummary() const {
+        static const char* const stations[kStationCount] = { "Cutting", "Bench work", "Glazing" };
+        float workMinutes = 0;
+
+        cout << fixed << setprecision(2);
+        cout << "\n--- Fabrication Estimate ---\n";
+        for (int st = 0; st < kStationCount; ++st) {
+            float capacity = makespan * config.machines[st];
+            cout << stations[st] << ": " << busy[st] / 60.0f << " h on " << config.machines[st]
+                 << " station(s), utilisation " << (capacity > 0 ? 100.0f * busy[st] / capacity : 0.0f) << "%\n";
+            workMinutes += busy[st];
         }
 
-        return sections;
+        float days = makespan / 60.0f / config.hoursPerDay;
+        cout << "Operations scheduled: " << slots.size() << "\n";
+        cout << "Makespan: " << makespan / 60.0f << " h (" << days << " working days at "
+             << config.hoursPerDay << " h/day)\n";
+        cout << "Delivery: about " << static_cast<int>(ceil(days)) << " working day(s) after start\n";
+        if (config.labourRatePerHour > 0)
+            cout << "Labour (" << workMinutes / 60.0f << " h): Rs. "
+                 << workMinutes / 60.0f * config.labourRatePerHour << "\n";
     }
 
-    float calculateTotalPrice(const map<string, float>& rates) const override {
-        auto sections = getRequiredSections();
-        float total = 0;
+    // One row per machine, '#' where busy during that time slice.
+    void printGantt(int columns = 60) const {
+        if (makespan <= 0) return;
 
-        for (const auto& s : sections) {
-            float inches = s.second;
-            float roundedFeet = roundToMarketFeet(inches);
-            float price = roundedFeet * rates.at(s.first);
-            total += price;
+        float slice = makespan / columns;
+        vector<vector<float>> load(machineCount(), vector<float>(columns, 0));
+        for (const auto& s : slots) {
+            for (int c = static_cast<int>(s.start / slice); c < columns && c * slice < s.end; ++c) {
+                float from = max(s.start, c * slice), to = min(s.end, (c + 1) * slice);
+                load[s.machine][c] += to - from;
+            }
+        }
 
-            cout << fixed << setprecision(2);
-            cout << s.first << ": " << inches << " inches = " << (inches / 12.0f)
-                 << " ft => rounded = " << roundedFeet << " => Rs. " << price << "\n";
+        cout << "\nGantt (each column = " << slice << " min)\n";
+        for (int m = 0; m < machineCount(); ++m) {
+            cout << left << setw(10) << machineName(m) << right << "|";
+            for (float used : load[m]) cout << (used >= slice * 0.5f ? '#' : used > 0 ? '+' : '.');
+            cout << "|\n";
         }
+    }
 
-        return total;
+    bool exportCsv(const string& path) const {
+        if (SessionJournal::get().replaying()) return true;
+        ofstream out(path);
+        if (!out) {
+            cerr << "❌ Error: Could not write " << path << "\n";
+            return false;
+        }
+
+        out << fixed << setprecision(2) << "window,machine,operation,start_min,end_min\n";
+        for (const auto& s : slots)
+            out << s.window + 1 << "," << machineName(s.machine) << "," << s.operation << ","
+                << s.start << "," << s.end << "\n";
+        return true;
     }
 
-private:
-    float roundToMarketFeet(float inches) const {
-        float ft = inches / 12.0f;
-        int whole = static_cast<int>(floor(ft));
-        float inchPart = (ft - whole) * 12;
+    static void benchmark(int count) {
+        mt19937 rng(2024);
+        vector<unique_ptr<FrameComponent>> owned;
+        vector<const FrameComponent*> windows;
+        for (int i = 0; i < count; ++i) {
+            WindowSpec spec = SectionRegression::randomSpec(rng);
+            owned.push_back(createComponent(spec.type));
+            owned.back()->loadSpec(spec);
+            windows.push_back(owned.back().get());
+        }
 
-        return inchPart <= 6.0f ? (whole + 0.6f) : (whole + 1.0f);
+        ShopScheduler scheduler;
+        auto start = chrono::steady_clock::now();
+        scheduler.schedule(windows);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        scheduler.printSummary();
+        cout << "Scheduled " << count << " windows (" << scheduler.operationCount()
+             << " operations) in " << seconds * 1000 << " ms\n";
     }
 };
 
-
 /////////////////////////////////////////////////////////
-// 🪟 Round Top Arch Window
+// 🕸️ Net Mesh Cutting (strip packing onto mesh rolls)
 /////////////////////////////////////////////////////////
 
-class RoundArchWindow : public FrameComponent {
-    float width = 0, arch = 0, T = 0, height = 0;
-    bool hasColler = false;
-    bool includeTee = false;
-
+// Mesh panels are cut from rolls of a fixed width. Panels are nested with
+// first-fit decreasing height (FFDH): tallest first, each into the first
+// shelf across the roll with room left, else onto a new shelf. The first
+// shelf with room is found through a max tree over the shelves' free width,
+// so large orders nest in O(n log n).
+class NetNester {
 public:
-    void inputDimensions() override {
-        cout << "Does the window have a coller? (1 = Yes, 0 = No): ";
-        cin >> hasColler;
-
-        do {
-            cout << "Enter Arch length (in inches): ";
-            cin >> arch;
-        } while (arch <= 0);
-
-        do {
-            cout << "Enter window width (in inches): ";
-            cin >> width;
-        } while (width <= 0);
-
-        do {
-            cout << "Enter approximate height for area calculation (used only for glass/labor): ";
-            cin >> height;
-        } while (height <= 0);
-
-        cout << "Do you want to add a Tee/Divider? (1 = Yes, 0 = No): ";
-        cin >> includeTee;
-
-        if (includeTee) {
-            do {
-                cout << "Enter Tee (Divider) size (in inches): ";
-                cin >> T;
-            } while (T <= 0);
+    struct Plan {
+        float rollWidth = 0;
+        float length = 0;        // inches of roll used
+        double panelArea = 0;    // square inches of mesh actually in panels
+        size_t panels = 0, shelves = 0, oversize = 0;
+
+        double waste() const {
+            double used = double(rollWidth) * length;
+            return used > 0 ? 100 * (1 - panelArea / used) : 0;
         }
-    }
-
-    void displayType() const override {
-        cout << "Round Arch Window\n";
-    }
+    };
 
-    float getArea() const override {
-        return (height / 12.0f) * (width / 12.0f);  // 👈 used only for square footage
+    // Cut sizes (panel plus allowance on every side) for all windows.
+    static vector<NetPanel> cutList(const vector<QuoteEntry>& windows, float allowance) {
+        vector<NetPanel> cuts;
+        unique_ptr<FrameComponent> scratch;
+        for (const auto& entry : windows)
+            for (const NetPanel& p : entry.view(scratch).getNetPanels())
+                if (p.height > 0 && p.width > 0)
+                    cuts.push_back({ p.height + 2 * allowance, p.width + 2 * allowance });
+        return cuts;
     }
 
-    map<string, float> getRequiredSections() const override {
-        map<string, float> sections;
-        float w = width;
-
-        if (hasColler) {
-            sections["D50F"] = arch + 12;
-            sections["D50A"] = w;
-        } else {
-            sections["D50A"] = arch + w + 12;
-        }
-
-        if (includeTee) {
-            sections["D40"] = T;
-            sections["D41"] = arch + w + 12 + (T * 2);
-        } else {
-            sections["D41"] = arch + w + 12;
+    static Plan nest(const vector<NetPanel>& cuts, float rollWidth) {
+        Plan plan;
+        plan.rollWidth = rollWidth;
+
+        // Longer side across the roll when it fits: shelves stay short.
+        vector<pair<float, float>> pieces;  // (along, across)
+        pieces.reserve(cuts.size());
+        for (const NetPanel& c : cuts) {
+            float longSide = max(c.height, c.width), shortSide = min(c.height, c.width);
+            if (longSide <= rollWidth) pieces.push_back({ shortSide, longSide });
+            else if (shortSide <= rollWidth) pieces.push_back({ longSide, shortSide });
+            else ++plan.oversize;
         }
+        sort(pieces.begin(), pieces.end(), greater<pair<float, float>>());
 
-        return sections;
-    }
+        size_t leaves = 1;
+        while (leaves < max<size_t>(pieces.size(), 1)) leaves *= 2;
+        vector<float> freeWidth(2 * leaves, -1);  // -1: shelf not opened yet
 
-    float calculateTotalPrice(const map<string, float>& rates) const override {
-        auto sections = getRequiredSections();
-        float total = 0;
+        auto update = [&](size_t shelf, float width) {
+            size_t i = shelf + leaves;
+            freeWidth[i] = width;
+            for (i /= 2; i >= 1; i /= 2) freeWidth[i] = max(freeWidth[2 * i], freeWidth[2 * i + 1]);
+        };
 
-        for (const auto& s : sections) {
-            float inches = s.second;
-            float roundedFeet = roundToMarketFeet(inches);
-            float price = roundedFeet * rates.at(s.first);
-            total += price;
+        const float kFit = 1e-3f;  // measurement noise, not a real gap
+        for (const auto& piece : pieces) {
+            float across = piece.second;
+            plan.panelArea += double(piece.first) * across;
+            ++plan.panels;
 
-            cout << fixed << setprecision(2);
-            cout << s.first << ": " << inches << " inches = " << (inches / 12.0f)
-                 << " ft => rounded = " << roundedFeet << " => Rs. " << price << "\n";
+            if (freeWidth[1] + kFit >= across) {
+                size_t i = 1;
+                while (i < leaves) i = (freeWidth[2 * i] + kFit >= across) ? 2 * i : 2 * i + 1;
+                update(i - leaves, freeWidth[i] - across);
+            } else {
+                // Decreasing order: the new shelf's first piece sets its height.
+                update(plan.shelves++, rollWidth - across);
+                plan.length += piece.first;
+            }
         }
-
-        return total;
+        return plan;
     }
 
-private:
-    float roundToMarketFeet(float inches) const {
-        float ft = inches / 12.0f;
-        int whole = static_cast<int>(floor(ft));
-        float inchPart = (ft - whole) * 12;
+    static void report(const vector<QuoteEntry>& windows, const ShopConfig& shop) {
+        auto start = chrono::steady_clock::now();
+        vector<NetPanel> cuts = cutList(windows, shop.meshAllowance);
+        if (cuts.empty()) {
+            cout << "ℹ️ No window in this project has a net.\n";
+            return;
+        }
 
-        return inchPart <= 6.0f ? (whole + 0.6f) : (whole + 1.0f);
+        vector<Plan> plans;
+        for (float width : shop.meshRolls) plans.push_back(nest(cuts, width));
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        const double kMetres = 0.0254;
+        cout << fixed << setprecision(2);
+        cout << "\n=== Net Mesh Cutting Plan ===\n";
+        cout << cuts.size() << " mesh panel(s), cut with " << shop.meshAllowance << "\" allowance per side\n";
+        cout << right << setw(10) << "Roll" << setw(12) << "Metres" << setw(8) << "Rolls"
+             << setw(9) << "Shelves" << setw(9) << "Waste" << setw(11) << "Oversize" << "\n";
+
+        size_t best = 0;
+        for (size_t i = 0; i < plans.size(); ++i) {
+            const Plan& p = plans[i];
+            double usedArea = double(p.rollWidth) * p.length, bestArea = double(plans[best].rollWidth) * plans[best].length;
+            if (p.oversize < plans[best].oversize || (p.oversize == plans[best].oversize && usedArea < bestArea))
+                best = i;
+
+            cout << setw(9) << setprecision(0) << p.rollWidth << "\"" << setw(12) << setprecision(2)
+                 << p.length * kMetres << setw(8) << (long)ceil(p.length / shop.meshRollLength)
+                 << setw(9) << p.shelves << setw(8) << p.waste() << "%" << setw(11) << p.oversize << "\n";
+        }
+
+        const Plan& p = plans[best];
+        cout << "\n✅ Best: " << setprecision(0) << p.rollWidth << "\" roll, " << setprecision(2)
+             << p.length * kMetres << " m (" << p.panelArea / 144 << " sqft in panels, "
+             << p.waste() << "% waste)";
+        if (p.oversize) cout << "; " << p.oversize << " panel(s) wider than the roll need joining";
+        cout << "\nNested in " << ms << " ms\n";
     }
 };
 
 /////////////////////////////////////////////////////////
-// 🪟 Fix Coner Window
+// 🪚 Cut List (every piece for the saw, grouped by profile and length)
 /////////////////////////////////////////////////////////
 
-class FixCornerWindow : public FrameComponent {
-    float h = 0, wl = 0, wr = 0, T = 0;
-    bool coller = false;
-    bool includeTee = false;
-
+// Pieces from the whole order are keyed by (profile, length in 1/16") and
+// put in order with an LSD radix sort, so 100k+ pieces sort in linear time.
+// Within a profile the longest pieces come first, the order they are cut
+// from stock bars. The sort is stable, so window numbers stay ascending.
+class CutList {
 public:
-    void inputDimensions() override {
-        cout << "Does this corner window have a coller? (1 = Yes, 0 = No): ";
-        cin >> coller;
+    static constexpr int kPerInch = 16;
+
+    struct Group {
+        string profile;
+        float length = 0;       // inches, rounded to 1/16"
+        int qty = 0;
+        int fromOffcuts = 0;    // pieces an offcut on the rack can cover
+        string labels;          // distinct labels, e.g. "H, W+9"
+        vector<int> windows;    // 1-based, ascending, one entry per piece
+    };
 
-        do {
-            cout << "Enter Height (in inches): ";
-            cin >> h;
-        } while (h <= 0);
+private:
+    struct Piece {
+        uint64_t key;
+        uint32_t window;
+        uint16_t label;
+    };
 
-        do {
-            cout << "Enter Left Width (in inches): ";
-            cin >> wl;
-        } while (wl <= 0);
+    static void radixSort(vector<Piece>& pieces) {
+        vector<Piece> buffer(pieces.size());
+        for (int shift = 0; shift < 64; shift += 8) {
+            size_t counts[257] = {};
+            for (const Piece& p : pieces) ++counts[((p.key >> shift) & 0xFF) + 1];
+            // Skip bytes every key shares (most of the length and profile bits).
+            if (any_of(counts + 1, counts + 257, [&](size_t c) { return c == pieces.size(); })) continue;
+
+            for (int b = 0; b < 256; ++b) counts[b + 1] += counts[b];
+            for (const Piece& p : pieces) buffer[counts[(p.key >> shift) & 0xFF]++] = p;
+            pieces.swap(buffer);
+        }
+    }
 
-        do {
-            cout << "Enter Right Width (in inches): ";
-            cin >> wr;
-        } while (wr <= 0);
+    static string windowRanges(const vector<int>& windows, size_t maxChars) {
+        string out;
+        for (size_t i = 0; i < windows.size();) {
+            size_t j = i;
+            while (j + 1 < windows.size() && windows[j + 1] <= windows[j] + 1) ++j;
+            if (!out.empty()) out += ' ';
+            out += to_string(windows[i]);
+            if (windows[j] != windows[i]) out += "-" + to_string(windows[j]);
+            if (out.size() > maxChars) return out + " ...";
+            i = j + 1;
+        }
+        return out;
+    }
 
-        cout << "Do you want to add a Tee/Divider? (1 = Yes, 0 = No): ";
-        cin >> includeTee;
+public:
+    // offcuts, when given, is drawn from piece by piece (pass a copy to
+    // preview without touching the stored inventory).
+    static vector<Group> build(const vector<QuoteEntry>& windows, OffcutInventory* offcuts = nullptr) {
+        unordered_map<string, uint32_t> profileIds, labelIds;
+        vector<string> profiles, labels;
+        auto intern = [](unordered_map<string, uint32_t>& ids, vector<string>& names, const string& name) {
+            auto it = ids.emplace(name, static_cast<uint32_t>(names.size()));
+            if (it.second) names.push_back(name);
+            return it.first->second;
+        };
 
-        if (includeTee) {
-            do {
-                cout << "Enter Tee size (in inches): ";
-                cin >> T;
-            } while (T <= 0);
+        vector<pair<uint32_t, uint32_t>> raw;  // (profile id, sixteenths)
+        vector<Piece> pieces;
+        vector<CutPiece> scratch;
+        unique_ptr<FrameComponent> windowScratch;
+        for (size_t i = 0; i < windows.size(); ++i) {
+            scratch.clear();
+            windows[i].view(windowScratch).getCutPieces(scratch);
+            for (const CutPiece& c : scratch) {
+                if (c.length <= 0) continue;
+                raw.push_back({ intern(profileIds, profiles, c.profile), static_cast<uint32_t>(lround(c.length * kPerInch)) });
+                pieces.push_back({ 0, static_cast<uint32_t>(i + 1), static_cast<uint16_t>(intern(labelIds, labels, c.label)) });
+            }
         }
+
+        // Profiles in name order, lengths descending.
+        vector<uint32_t> rank(profiles.size());
+        vector<uint32_t> byName(profiles.size());
+        for (uint32_t id = 0; id < byName.size(); ++id) byName[id] = id;
+        sort(byName.begin(), byName.end(), [&](uint32_t a, uint32_t b) { return profiles[a] < profiles[b]; });
+        for (uint32_t r = 0; r < byName.size(); ++r) rank[byName[r]] = r;
+        for (size_t i = 0; i < pieces.size(); ++i)
+            pieces[i].key = uint64_t(rank[raw[i].first]) << 32 | (0xFFFFFFFFu - raw[i].second);
+
+        radixSort(pieces);
+
+        vector<Group> groups;
+        for (size_t i = 0; i < pieces.size();) {
+            Group g;
+            g.profile = profiles[byName[pieces[i].key >> 32]];
+            g.length = float(0xFFFFFFFFu - uint32_t(pieces[i].key)) / kPerInch;
+
+            set<uint16_t> seen;
+            size_t j = i;
+            for (; j < pieces.size() && pieces[j].key == pieces[i].key; ++j) {
+                g.windows.push_back(static_cast<int>(pieces[j].window));
+                if (seen.insert(pieces[j].label).second)
+                    g.labels += (g.labels.empty() ? "" : ", ") + labels[pieces[j].label];
+
+                float used;
+                if (offcuts && offcuts->take(g.profile, g.length, used)) ++g.fromOffcuts;
+            }
+            g.qty = static_cast<int>(j - i);
+            groups.push_back(move(g));
+            i = j;
+        }
+        return groups;
     }
 
-    void displayType() const override {
-        cout << "Fix Corner Window\n";
+    static void print(const vector<Group>& groups, size_t maxRows = 60) {
+        size_t pieces = 0, fromOffcuts = 0;
+        for (const Group& g : groups) {
+            pieces += g.qty;
+            fromOffcuts += g.fromOffcuts;
+        }
+
+        cout << fixed << setprecision(2);
+        cout << "\n=== Cut List: " << pieces << " piece(s) in " << groups.size() << " length group(s) ===\n";
+        string current;
+        size_t shown = 0;
+        for (const Group& g : groups) {
+            if (shown++ == maxRows) {
+                cout << "... " << groups.size() - maxRows << " more group(s); export for the full list\n";
+                break;
+            }
+            if (g.profile != current) {
+                current = g.profile;
+                cout << "\n" << current << "\n";
+            }
+            cout << "  " << right << setw(9) << g.length << " in  x" << left << setw(5) << g.qty
+                 << setw(16) << g.labels;
+            if (g.fromOffcuts) cout << "(" << g.fromOffcuts << " from offcuts) ";
+            cout << "windows " << windowRanges(g.windows, 40) << "\n";
+        }
+        cout << right;
+        if (fromOffcuts) cout << "\n♻️ " << fromOffcuts << " piece(s) can be cut from stored offcuts\n";
     }
 
-    float getArea() const override {
-        float totalWidth = wl + wr;
-        return (h / 12.0f) * (totalWidth / 12.0f);  // Just for glass/labor estimation
+    static bool exportCsv(const vector<Group>& groups, const string& path) {
+        if (SessionJournal::get().replaying()) return true;
+        ofstream out(path);
+        if (!out) return false;
+        out << "profile,length_in,qty,from_offcuts,labels,windows\n";
+        out << fixed << setprecision(4);
+        for (const Group& g : groups)
+            out << g.profile << "," << g.length << "," << g.qty << "," << g.fromOffcuts << ",\""
+                << g.labels << "\"," << windowRanges(g.windows, string::npos) << "\n";
+        return true;
     }
 
-    map<string, float> getRequiredSections() const override {
-        map<string, float> sections;
+    // Builds the cut list for N synthetic windows.
+    static void benchmark(size_t count);
+};
 
-        if (coller)
-            sections["D54F"] = (h * 2) + ((wl + wr) * 2) + 18;
-        else
-            sections["D54A"] = (h * 2) + ((wl + wr) * 2);
+// Resident set size of this process in MB, 0 where /proc is unavailable.
+double residentMB() {
+    ifstream statm("/proc/self/statm");
+    long pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return resident * 4096.0 / (1024 * 1024);
+}
 
-        if (includeTee) {
-            sections["D40"] = T;
-            sections["D41"] = (h * 2) + ((wl + wr) * 2) + (T * 2);
-        } else {
-            sections["D41"] = (h * 2) + ((wl + wr) * 2);
-        }
+// Needs SectionRegression and residentMB, so it lives after them. Every
+// sampled window, packed or kept as it was, must give back its source spec
+// and the same sections.
+void PackedWindowStore::benchmark(size_t count) {
+    size_t sample = min<size_t>(count, 100000), stride = max<size_t>(count / max<size_t>(sample, 1), 1);
+    vector<WindowSpec> sources;  // the sampled windows as generated
+    sources.reserve(sample);
+
+    double before = residentMB();
+    mt19937 rng(7);
+    PackedWindowStore store;
+    store.reserve(count);
+
+    auto start = chrono::steady_clock::now();
+    WindowSpec spec;
+    for (size_t i = 0; i < count; ++i) {
+        SectionRegression::randomSpec(rng, spec);
+        store.add(spec, i % 2 ? "GF" : "F1");
+        if (i % stride == 0 && sources.size() < sample) sources.push_back(spec);
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    double grew = residentMB() - before;
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        bool sameSpec = formatSpec(store.unpack(i * stride)) == formatSpec(sources[i]);
+        auto win = store.materialize(i * stride);
+        if (!sameSpec || !SectionRegression::sameSections(win->getRequiredSections(),
+                                                          SectionRegression::reference(sources[i])))
+            ++mismatches;
+    }
+
+    double fullMB = 0;
+    for (int type = 1; type <= ComponentRegistry::count(); ++type) {
+        auto win = createComponent(type);
+        fullMB += sizeof(*win) + sizeof(unique_ptr<FrameComponent>) + 16;  // + allocator header
+    }
+    fullMB = fullMB / ComponentRegistry::count() * count / (1024 * 1024);
+
+    cout << fixed << setprecision(2);
+    cout << "Packed " << count << " windows in " << seconds << " s; " << count - store.verbatimCount()
+         << " in 16 bytes, " << store.verbatimCount() << " kept as full specs (a size off the 1/16\" grid)\n";
+    cout << "Store: " << store.bytes() / (1024.0 * 1024) << " MB ("
+         << double(store.bytes()) / max<size_t>(count, 1) << " bytes/window, "
+         << store.segmentLists.size() - 1 << " distinct bay segment lists), process RSS grew "
+         << grew << " MB\n";
+    cout << "Same windows as objects: ~" << fullMB << " MB before section maps\n";
+    cout << (mismatches ? "❌ " : "✅ ") << sources.size() - mismatches << "/" << sources.size()
+         << " sampled windows give back their source spec and sections\n";
+}
+
+/////////////////////////////////////////////////////////
+// 🏘️ Synthetic Orders & Soak Test (tender-sized projects)
+/////////////////////////////////////////////////////////
 
-        return sections;
+// Orders shaped like a housing-society tender: mostly sliding and fixed
+// windows, a door or two per flat, few arches and corners. Sizes are drawn
+// around common openings and rounded to 1/8", like site measurements.
+class OrderGenerator {
+    mt19937 rng;
+    discrete_distribution<int> pickType;
+    vector<string> floors = { "GF", "F1", "F2", "F3", "F4", "F5" };
+
+    // A type's share of the order and its usual opening in inches: mean,
+    // spread and clamp for the height, then the same for the width.
+    struct Opening { double share; float h, hSpread, hLo, hHi, w, wSpread, wLo, wHi; };
+
+    // By type name; a type not listed here (a bay, a plug-in) gets a small
+    // share of average openings.
+    static const Opening& opening(const string& type) {
+        static const Opening other = { 1, 54, 10, 30, 84, 48, 12, 24, 96 };
+        static const map<string, Opening> openings = {
+            { "three-panel",        { 20, 48, 10, 24, 84, 60, 15, 24, 120 } },
+            { "two-panel-m",        { 14, 48, 10, 24, 84, 60, 15, 24, 120 } },
+            { "three-panel-3glass", { 8,  48, 10, 24, 84, 60, 15, 24, 120 } },
+            { "two-panel-3glass-m", { 6,  48, 10, 24, 84, 60, 15, 24, 120 } },
+            { "fixed",              { 12, 42, 12, 18, 72, 48, 15, 18, 96 } },
+            { "random-fixed",       { 3,  0,  0,  0,  0,  96, 40, 24, 240 } },
+            { "openable",           { 8,  42, 8,  24, 60, 24, 4,  18, 36 } },
+            { "single-door",        { 12, 82, 3,  72, 96, 36, 3,  28, 42 } },
+            { "double-door",        { 5,  84, 3,  72, 96, 60, 6,  48, 72 } },
+            { "qadial-arch",        { 2,  54, 10, 30, 84, 48, 12, 24, 96 } },
+            { "round-arch",         { 2,  54, 10, 30, 84, 48, 12, 24, 96 } },
+            { "fix-corner",         { 2,  54, 10, 30, 84, 48, 12, 24, 96 } },
+            { "slide-corner",       { 4,  54, 10, 30, 84, 48, 12, 24, 96 } },
+            { "slide-corner-m",     { 2,  54, 10, 30, 84, 48, 12, 24, 96 } },
+        };
+        auto it = openings.find(type);
+        return it == openings.end() ? other : it->second;
     }
 
-    float calculateTotalPrice(const map<string, float>& rates) const override {
-        auto sections = getRequiredSections();
-        float total = 0;
+    static vector<double> typeWeights() {
+        vector<double> w;
+        for (int type = 1; type <= ComponentRegistry::count(); ++type)
+            w.push_back(opening(ComponentRegistry::find(type)->name).share);
+        return w;
+    }
 
-        for (const auto& s : sections) {
-            float inches = s.second;
-            float roundedFeet = roundToMarketFeet(inches);
-            float price = roundedFeet * rates.at(s.first);
-            total += price;
+    bool chance(double p) { return uniform_real_distribution<double>(0, 1)(rng) < p; }
 
-            cout << fixed << setprecision(2);
-            cout << s.first << ": " << inches << " inches = "
-                 << (inches / 12.0f) << " ft => rounded = "
-                 << roundedFeet << " => Rs. " << price << "\n";
-        }
+    float size(float mean, float spread, float lo, float hi) {
+        float v = normal_distribution<float>(mean, spread)(rng);
+        return round(min(hi, max(lo, v)) * 8) / 8;
+    }
 
-        return total;
+    // Lower collar numbers are the everyday profiles.
+    int collar(int range) {
+        vector<double> w;
+        for (int c = 1; c <= range; ++c) w.push_back(1.0 / c);
+        return discrete_distribution<int>(w.begin(), w.end())(rng) + 1;
     }
 
-private:
-    float roundToMarketFeet(float inches) const {
-        float ft = inches / 12.0f;
-        int whole = static_cast<int>(floor(ft));
-        float inchPart = (ft - whole) * 12;
-        return (inchPart <= 6.0f) ? (whole + 0.6f) : (whole + 1.0f);
+public:
+    explicit OrderGenerator(unsigned seed) : rng(seed) {
+        vector<double> w = typeWeights();
+        pickType = discrete_distribution<int>(w.begin(), w.end());
     }
-};
 
-/////////////////////////////////////////////////////////
-// 🪟 Slide Corner Window
-/////////////////////////////////////////////////////////
+    const string& floorTag() { return floors[rng() % floors.size()]; }
+
+    WindowSpec next() {
+        WindowSpec s;
+        s.type = pickType(rng) + 1;
+        const WindowTypeInfo& info = *ComponentRegistry::find(s.type);
+        const Opening& o = opening(info.name);
+        s.collar = collar(info.collars);
+
+        float wr = size(36, 8, 18, 60), arch = size(20, 5, 10, 36);
+        float h = info.uses("h") ? size(o.h, o.hSpread, o.hLo, o.hHi) : 0;
+        float w = size(o.w, o.wSpread, o.wLo, o.wHi);
+
+        // Options the type takes, drawn in this order.
+        if (info.uses("shape")) s.archShape = chance(0.6) ? 0 : 1 + rng() % 3;
+        if (info.uses("net")) s.netType = discrete_distribution<int>({ 4, 3, 2, 1 })(rng) + 1;
+        if (info.uses("hasnet")) s.hasNet = chance(0.6);
+        if (info.uses("d46")) s.includeD46 = chance(0.4);
+        if (info.uses("coller")) s.hasColler = chance(0.7);
+        if (info.uses("segments")) {
+            int segments = 3 + rng() % 3;
+            for (int i = 0; i < segments; ++i) s.segments += i ? (chance(0.5) ? ",S" : ",F") : (chance(0.5) ? "S" : "F");
+        }
+        if (info.uses("tee")) s.includeTee = s.segments.find('S') == string::npos && chance(0.3);  // none across a slider
 
-class SlideCornerWindow : public FrameComponent {
-    float height = 0, wl = 0, wr = 0, d29Width = 0;
-    int subtype = 1;
-    bool includeD29 = true;
-    bool useColler = true;
-    string sec30, sec26;
+        SectionRegression::fillDimensions(s, h, w, wr, size(18, 3, 12, 24), size(24, 3, 18, 30), arch);
+        return s;
+    }
+};
 
+// Prices and summarises fresh synthetic orders round after round. Per round
+// it reports throughput, resident memory after the order is dropped, and how
+// far the float aluminium total (kept the way main() keeps totalAluminium)
+// has drifted from the same sum kept exactly.
+class SoakTest {
 public:
-    SlideCornerWindow(bool d29, string s30, string s26)
-        : includeD29(d29), sec30(s30), sec26(s26) {}
+    // One rate per profile code seen in a sample order.
+    static map<string, float> syntheticRates(unsigned seed) {
+        OrderGenerator gen(seed);
+        mt19937 rng(seed);
+        uniform_int_distribution<int> rupees(150, 900);
+        map<string, float> rates;
+        for (int i = 0; i < 20000; ++i) {
+            WindowSpec spec = gen.next();
+            auto win = createComponent(spec.type);
+            win->loadSpec(spec);
+            for (const auto& s : win->getRequiredSections())
+                if (!rates.count(s.first)) rates[s.first] = static_cast<float>(rupees(rng));
+        }
+        return rates;
+    }
 
-    void inputDimensions() override {
-        cout << "\n--- Slide Corner Window ---\n";
-        cout << "Select subtype:\n";
-        cout << "1. Left Side Fix Corner\n";
-        cout << "2. Right Side Fix Corner\n";
-        cout << "3. Center Fix Corner\n";
-        cout << "4. Center Fix (Far) Corner\n";
-        cout << "5. Center Slide Corner\n";
-        cin >> subtype;
+    static bool run(size_t windowsPerRound, int rounds) {
+        auto rates = make_shared<const RateTable>(syntheticRates(99));
+        float sessionAluminium = 0;  // running float total across rounds, like main()
+        long double sessionExact = 0;
+        vector<double> throughput;
+        double firstRss = 0;
+        bool consistent = true;
+
+        cout << fixed << setprecision(2);
+        cout << "Soak: " << rounds << " round(s) of " << windowsPerRound << " windows, "
+             << rates->byName().size() << " priced profiles\n";
+        cout << right << setw(5) << "Round" << setw(12) << "Windows/s" << setw(10) << "RSS MB"
+             << setw(20) << "Round aluminium" << setw(14) << "Round drift" << setw(16) << "Session drift" << "\n";
+
+        for (int round = 1; round <= rounds; ++round) {
+            OrderGenerator gen(1000 + round);
+            auto start = chrono::steady_clock::now();
+
+            vector<QuoteEntry> order;
+            order.reserve(windowsPerRound);
+            float roundAluminium = 0;
+            long double roundExact = 0;
+
+            for (size_t i = 0; i < windowsPerRound; ++i) {
+                WindowSpec spec = gen.next();
+                QuoteEntry entry;
+                entry.window = createComponent(spec.type);
+                entry.window->loadSpec(spec);
+                entry.type = spec.type;
+                entry.tag = gen.floorTag();
+                entry.rates = rates;
+
+                float price = 0;
+                for (const auto& s : entry.window->requiredSections()) {
+                    float cost;
+                    if (!entry.window->sectionCost(s.id, s.second, *rates, cost)) continue;
+                    price += cost;
+                    roundExact += static_cast<long double>(entry.window->roundToMarketFeet(s.second)) * rates->rate(s.id);
+                }
+                roundAluminium += price;
+                order.push_back(move(entry));
+            }
 
-        cout << "Do you want to use coller style? (1 = Yes, 0 = No): ";
-        cin >> useColler;
+            ProjectSummary summary;
+            for (const auto& entry : order) summary.add(entry);
+            order.clear();
+            order.shrink_to_fit();
+
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            addMeasuredSeconds(seconds);
+            throughput.push_back(windowsPerRound / max(seconds, 1e-9));
+            sessionAluminium += roundAluminium;
+            sessionExact += roundExact;
+
+            // The summary adds the same costs in another order; both sides
+            // carry float rounding, so allow a relative margin.
+            if (fabs(summary.aluminium() - roundAluminium) > 1e-3 * fabs((double)roundExact) + 0.01)
+                consistent = false;
+
+            double rss = residentMB();
+            if (round == 1) firstRss = rss;
+            cout << setw(5) << round << setw(12) << setprecision(0) << throughput.back()
+                 << setw(10) << setprecision(1) << rss << setw(20) << setprecision(2) << roundAluminium
+                 << setw(14) << (double)(roundAluminium - roundExact)
+                 << setw(16) << (double)(sessionAluminium - sessionExact) << "\n";
+        }
 
-        do {
-            cout << "Enter Height (in inches): ";
-            cin >> height;
-        } while (height <= 0);
+        double mean = 0, var = 0;
+        for (double t : throughput) mean += t / throughput.size();
+        for (double t : throughput) var += (t - mean) * (t - mean) / throughput.size();
+
+        cout << "\nThroughput: " << setprecision(0) << mean << " windows/s, variation "
+             << setprecision(1) << (mean > 0 ? 100 * sqrt(var) / mean : 0) << "%\n";
+        cout << "Memory growth after round 1: " << residentMB() - firstRss << " MB\n";
+        cout << setprecision(2) << "Session aluminium: float Rs. " << sessionAluminium << ", exact Rs. "
+             << (double)sessionExact << " (drift " << setprecision(6)
+             << (sessionExact != 0 ? 100 * (double)((sessionAluminium - sessionExact) / sessionExact) : 0.0)
+             << "%)\n";
+        cout << (consistent ? "✅ Summary totals matched pricing every round\n"
+                            : "❌ Summary totals disagreed with pricing\n");
+        return consistent;
+    }
+};
 
-        do {
-            cout << "Enter Width (Left side) (in inches): ";
-            cin >> wl;
-        } while (wl <= 0);
+/////////////////////////////////////////////////////////
+// 📈 Rate Scenarios (low / expected / high in one pass)
+/////////////////////////////////////////////////////////
 
-        do {
-            cout << "Enter Width (Right side) (in inches): ";
-            cin >> wr;
-        } while (wr <= 0);
+// rate_scenarios.csv, one column per scenario:
+//     section,low,expected,high
+//     D41,70,80,95
+// A blank cell leaves that section at the rate its batch was priced with.
+// Rates are stored section-major, so pricing a section for all K scenarios
+// is one contiguous multiply-add the compiler vectorizes.
+class RateScenarios {
+    vector<string> names;
+    vector<int> rowById;      // SectionCodes ID -> matrix row, -1 = not in the file
+    vector<float> matrix;     // matrix[id * K + k], NaN where the cell was blank
+    vector<char> hasBlank;    // per section: some scenario left it blank
+
+    size_t K() const { return names.size(); }
+
+    int internSection(const string& code) {
+        int section = SectionCodes::id(code);
+        if (section < 0) return -1;
+        if (section >= static_cast<int>(rowById.size())) rowById.resize(section + 1, -1);
+        if (rowById[section] >= 0) return rowById[section];
+
+        int id = static_cast<int>(hasBlank.size());
+        rowById[section] = id;
+        matrix.resize(matrix.size() + K(), NAN);
+        hasBlank.push_back(1);
+        return id;
+    }
 
-        if (subtype == 4 && includeD29) {
-            do {
-                cout << "Enter custom width for D29 (in inches): ";
-                cin >> d29Width;
-            } while (d29Width <= 0);
-        }
+    int rowOf(int section) const {
+        return (section >= 0 && section < static_cast<int>(rowById.size())) ? rowById[section] : -1;
     }
 
-    void displayType() const override {
-        cout << "Slide Corner Window - ";
-        switch (subtype) {
-            case 1: cout << "Left Side Fix\n"; break;
-            case 2: cout << "Right Side Fix\n"; break;
-            case 3: cout << "Center Fix\n"; break;
-            case 4: cout << "Center Fix (Far)\n"; break;
-            case 5: cout << "Center Slide\n"; break;
+    void setRow(int id, const vector<float>& row) {
+        bool blank = false;
+        for (size_t k = 0; k < K(); ++k) {
+            matrix[id * K() + k] = row[k];
+            blank |= isnan(row[k]);
         }
+        hasBlank[id] = blank;
     }
 
-    float getArea() const override {
-        return (height / 12.0f) * ((wl + wr) / 12.0f);
+public:
+    size_t count() const { return names.size(); }
+    const string& name(size_t k) const { return names[k]; }
+
+    bool load(const string& path = "rate_scenarios.csv") {
+        string text;
+        bool found = SessionJournal::get().readFile(path, text);
+        istringstream in(text);
+        string line, cell;
+        if (!found || !getline(in, line)) return false;
+
+        // Header: section,<scenario>,<scenario>...
+        istringstream header(line);
+        getline(header, cell, ',');
+        while (getline(header, cell, ',')) names.push_back(cell);
+        if (names.empty()) return false;
+
+        int lineNo = 1;
+        while (getline(in, line)) {
+            ++lineNo;
+            if (line.empty() || line[0] == '#') continue;
+
+            istringstream fields(line);
+            string code;
+            getline(fields, code, ',');
+            vector<float> row(K(), NAN);
+            bool ok = !code.empty();
+            for (size_t k = 0; k < K() && getline(fields, cell, ','); ++k) {
+                if (cell.empty()) continue;
+                char* end = nullptr;
+                row[k] = strtof(cell.c_str(), &end);
+                if (end == cell.c_str() || row[k] < 0) ok = false;
+            }
+            if (!ok) {
+                cerr << "⚠️ Skipping line " << lineNo << " of " << path << ": " << line << "\n";
+                continue;
+            }
+            int id = internSection(code);
+            if (id >= 0) setRow(id, row);
+        }
+        return true;
     }
 
-    map<string, float> getRequiredSections() const override {
-        map<string, float> sections;
-        string suffix30 = useColler ? "F" : "A";
-        string suffix26 = useColler ? "F" : "A";
-        string sec30Full = sec30 + suffix30;
-        string sec26Full = sec26 + suffix26;
+    // K full rate tables, e.g. for benchmarks.
+    static RateScenarios fromTables(const vector<pair<string, map<string, float>>>& tables) {
+        RateScenarios r;
+        for (const auto& t : tables) r.names.push_back(t.first);
+        for (size_t k = 0; k < tables.size(); ++k)
+            for (const auto& rate : tables[k].second) {
+                int id = r.internSection(rate.first);
+                if (id >= 0) r.matrix[id * r.K() + k] = rate.second;
+            }
+        for (size_t id = 0; id < r.hasBlank.size(); ++id) {
+            bool blank = false;
+            for (size_t k = 0; k < r.K(); ++k) blank |= isnan(r.matrix[id * r.K() + k]);
+            r.hasBlank[id] = blank;
+        }
+        return r;
+    }
 
-        float c30Add = useColler ? 12.0f : 0.0f;
-        float c26Add = useColler ? 6.0f : 0.0f;
+    // Adds the window's aluminium under every scenario to totals[0..K).
+    // Sections the file does not vary use the batch rate; sections without
+    // any rate are left out, as in calculateTotalPrice().
+    void price(const FrameComponent& win, const RateTable& batchRates, float* totals) const {
+        const size_t k = K();
+        for (const auto& s : win.requiredSections()) {
+            float feet = win.roundToMarketFeet(s.second);
+            int id = rowOf(s.id);
+            float batch = batchRates.rate(s.id);
+
+            if (id >= 0 && !hasBlank[id]) {
+                const float* row = &matrix[id * k];
+                for (size_t j = 0; j < k; ++j) totals[j] += feet * row[j];
+                continue;
+            }
 
-        if (subtype == 1) {  // Left Side Fix
-            sections[sec30Full] = ((height + wl + wr) * 2) + c30Add;
-            sections[sec26Full] = wl + wr + c26Add;
-            if (includeD29) sections["D29"] = (height * 2) + wr;
-        }
-        else if (subtype == 2) {  // Right Side Fix
-            sections[sec30Full] = ((height + wl + wr) * 2) + c30Add;
-            sections[sec26Full] = wl + wr + c26Add;
-            if (includeD29) sections["D29"] = (height * 2) + wl;
+            for (size_t j = 0; j < k; ++j) {
+                float r = id >= 0 ? matrix[id * k + j] : NAN;
+                if (isnan(r)) {
+                    if (isnan(batch)) continue;
+                    r = batch;
+                }
+                totals[j] += feet * r;
+            }
         }
-        else if (subtype == 3) {  // Center Fix
-            sections[sec30Full] = (height * 2) + wl + wr + c30Add;
-            sections[sec26Full] = wl + wr + c26Add;
-            if (includeD29) sections["D29"] = (height * 4) + wl + wr;
+    }
+
+    // Per-window band and per-scenario project totals.
+    void report(const vector<QuoteEntry>& windows, size_t maxRows = 30) const {
+        const size_t k = K();
+        vector<float> project(k, 0), totals(k);
+
+        cout << fixed << setprecision(2);
+        cout << "\n=== Aluminium by Rate Scenario (" << k << " scenario(s)) ===\n";
+        cout << left << setw(48) << "Window" << right << setw(14) << "Low" << setw(14) << "High"
+             << setw(10) << "Spread" << "\n";
+
+        unique_ptr<FrameComponent> scratch;
+        for (size_t i = 0; i < windows.size(); ++i) {
+            const QuoteEntry& entry = windows[i];
+            fill(totals.begin(), totals.end(), 0.0f);
+            price(entry.view(scratch), *entry.rates, totals.data());
+            for (size_t j = 0; j < k; ++j) project[j] += totals[j];
+
+            if (i >= maxRows) continue;
+            auto band = minmax_element(totals.begin(), totals.end());
+            string label = "#" + to_string(i + 1) + " " + windowTypeName(entry.type) +
+                           (entry.tag != "-" ? " [" + entry.tag + "]" : "");
+            cout << left << setw(48) << label << right << setw(14) << *band.first << setw(14) << *band.second
+                 << setw(9) << (*band.first > 0 ? 100 * (*band.second - *band.first) / *band.first : 0) << "%\n";
         }
-        else if (subtype == 4) {  // Center Fix (Far)
-            sections[sec30Full] = (height * 2) + wl + wr + c30Add;
-            sections[sec26Full] = wl + wr + c26Add;
-            if (includeD29) sections["D29"] = (height * 4) + (d29Width * 4);
+        if (windows.size() > maxRows) cout << "... " << windows.size() - maxRows << " more window(s)\n";
+
+        cout << "\nProject aluminium (before discount):\n";
+        for (size_t j = 0; j < k; ++j) cout << "  " << left << setw(16) << names[j] << right << "Rs. " << project[j] << "\n";
+        auto band = minmax_element(project.begin(), project.end());
+        cout << "Band: Rs. " << *band.first << " to Rs. " << *band.second << "\n";
+    }
+
+    // Times K = 1 and K = 16 over the same synthetic order. Windows and
+    // their section maps are built once, untimed by the passes, so each pass
+    // measures only the rate x section products.
+    static void benchmark(size_t count) {
+        map<string, float> base = SoakTest::syntheticRates(99);
+        vector<pair<string, map<string, float>>> tables;
+        for (int k = 0; k < 16; ++k) {
+            map<string, float> t = base;
+            for (auto& r : t) r.second *= 0.85f + 0.02f * k;
+            tables.push_back({ "s" + to_string(k + 1), move(t) });
         }
-        else if (subtype == 5) {  // Center Slide
-            sections[sec30Full] = (height * 2) + wl + wr + c30Add;
-            sections[sec26Full] = wl + wr + c26Add;
-            if (includeD29) sections["D29"] = (height * 4) + wl + wr;
+        RateScenarios one = fromTables({ tables[0] });
+        RateScenarios sixteen = fromTables(tables);
+        RateTable batchRates(base);
+
+        OrderGenerator gen(5);
+        vector<unique_ptr<FrameComponent>> order;
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < count; ++i) {
+            WindowSpec spec = gen.next();
+            order.push_back(createComponent(spec.type));
+            order.back()->loadSpec(spec);
+            order.back()->requiredSections();
         }
+        double build = chrono::duration<double>(chrono::steady_clock::now() - start).count();
 
-        sections["M23"] = height * ((subtype == 5) ? 4 : 2);
-        sections["M28"] = height * ((subtype == 1 || subtype == 2) ? 2 : 4);
-        sections["M24"] = (wl + wr) * 2;
+        auto pass = [&](const RateScenarios& scenarios, vector<float>& project) {
+            project.assign(scenarios.count(), 0);
+            auto start = chrono::steady_clock::now();
+            for (size_t i = 0; i < count; ++i) scenarios.price(*order[i], batchRates, project.data());
+            return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        };
 
-        return sections;
+        vector<float> projectOne, projectSixteen;
+        pass(one, projectOne);  // warm up allocator and caches
+        double t1 = pass(one, projectOne);
+        double t16 = pass(sixteen, projectSixteen);
+        addMeasuredSeconds(t16);
+
+        // Scenario 1 priced alone and among sixteen must agree.
+        bool same = fabs(projectOne[0] - projectSixteen[0]) <= 1e-6f * fabs(projectOne[0]);
+
+        cout << fixed << setprecision(3);
+        cout << "Built " << count << " windows and their section maps in " << build << " s (not in the passes)\n";
+        cout << "Priced " << count << " windows: K=1 in " << t1 << " s, K=16 in " << t16 << " s ("
+             << setprecision(2) << t16 / max(t1, 1e-9) << "x the time for 16x the scenarios, "
+             << setprecision(1) << t16 * 1e9 / max<size_t>(count * 16, 1) << " ns per window-scenario)\n" << setprecision(2);
+        cout << (same ? "✅ " : "❌ ") << "Scenario 1 total Rs. " << projectOne[0]
+             << (same ? " matches" : " differs from") << " the K=16 pass (Rs. " << projectSixteen[0] << ")\n";
     }
+};
 
-    float calculateTotalPrice(const map<string, float>& rates) const override {
-        auto sections = getRequiredSections();
-        float total = 0;
+// Needs OrderGenerator, so it lives after it.
+void CutList::benchmark(size_t count) {
+    OrderGenerator gen(13);
+    vector<QuoteEntry> order(count);
+    for (auto& entry : order) {
+        WindowSpec spec = gen.next();
+        entry.window = createComponent(spec.type);
+        entry.window->loadSpec(spec);
+        entry.type = spec.type;
+    }
 
-        for (const auto& s : sections) {
-            float inches = s.second;
-            float feet = inches / 12.0f;
-            float roundedFeet = roundToMarketFeet(inches);
-            float price = roundedFeet * rates.at(s.first);
-            total += price;
+    auto start = chrono::steady_clock::now();
+    vector<Group> groups = build(order);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    addMeasuredSeconds(seconds);
 
-            cout << fixed << setprecision(2);
-            cout << s.first << ": " << inches << " in = " << feet
-                 << " ft → rounded = " << roundedFeet << " → Rs. " << price << "\n";
-        }
+    size_t pieces = 0;
+    for (const Group& g : groups) pieces += g.qty;
+    cout << fixed << setprecision(3);
+    cout << "Cut list for " << count << " windows: " << pieces << " pieces in " << groups.size()
+         << " length groups, built in " << seconds << " s\n";
+}
 
-        return total;
+// Needs OrderGenerator, so it lives after it.
+void ProjectTree::benchmark(size_t count) {
+    OrderGenerator gen(23);
+    mt19937 rng(23);
+    auto rates = make_shared<const RateTable>(SoakTest::syntheticRates(99));
+    auto place = [&] {
+        return "Site" + to_string(rng() % 3 + 1) + "/F" + to_string(rng() % 12) + "/Room" + to_string(rng() % 20 + 1);
+    };
+
+    vector<QuoteEntry> order(count);
+    for (auto& entry : order) {
+        WindowSpec spec = gen.next();
+        entry.window = createComponent(spec.type);
+        entry.window->loadSpec(spec);
+        entry.type = spec.type;
+        entry.tag = place();
+        entry.rates = rates;
     }
 
-private:
-    float roundToMarketFeet(float inches) const {
-        float ft = inches / 12.0f;
-        int whole = static_cast<int>(floor(ft));
-        float inch = (ft - whole) * 12;
+    auto seconds = [](chrono::steady_clock::time_point since) {
+        return chrono::duration<double>(chrono::steady_clock::now() - since).count();
+    };
 
-        return (inch <= 6.0f) ? (whole + 0.6f) : (whole + 1.0f);
+    ProjectTree tree;
+    auto start = chrono::steady_clock::now();
+    for (auto& entry : order) entry.treeId = tree.insert(entry);
+    double insertSeconds = seconds(start);
+
+    // Moves, re-dimensions and remove + re-add, in equal parts.
+    size_t edits = min<size_t>(count, 100000);
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < edits && count; ++i) {
+        QuoteEntry& entry = order[rng() % count];
+        if (i % 3 == 0) {
+            entry.tag = place();
+            tree.update(entry.treeId, entry);
+        } else if (i % 3 == 1) {
+            WindowSpec spec = entry.window->getSpec();
+            spec.width += 1;
+            entry.window->loadSpec(spec);
+            tree.update(entry.treeId, entry);
+        } else {
+            tree.remove(entry.treeId);
+            entry.treeId = tree.insert(entry);
+        }
     }
-};
-
-/////////////////////////////////////////////////////////
-// 🧠 Final Cost Summary Class
-/////////////////////////////////////////////////////////
+    double editSeconds = seconds(start);
+
+    const size_t queries = 1000000;
+    vector<string> paths;
+    for (int i = 0; i < 256; ++i) paths.push_back(i % 4 == 0 ? "Site" + to_string(i % 3 + 1) : place());
+    long long seen = 0;
+    start = chrono::steady_clock::now();
+    for (size_t q = 0; q < queries; ++q)
+        if (const Totals* t = tree.find(paths[q & 255])) seen += t->windows;
+    double querySeconds = seconds(start);
+    addMeasuredSeconds(insertSeconds + editSeconds + querySeconds);
+
+    // The same windows inserted into a fresh tree must give the same totals.
+    ProjectTree fresh;
+    for (const auto& entry : order) fresh.insert(entry);
+    double drift = fabs(tree.project().aluminium - fresh.project().aluminium);
+
+    cout << fixed << setprecision(3);
+    cout << "Project tree, " << count << " windows in " << tree.nodes.size() << " nodes:\n"
+         << "  insert: " << insertSeconds << " s\n"
+         << "  " << edits << " edits (move / resize / remove+add): " << editSeconds << " s ("
+         << editSeconds / max<size_t>(edits, 1) * 1e6 << " us each)\n"
+         << "  " << queries << " subtotal lookups: " << querySeconds << " s (" << seen << " windows seen)\n";
+    cout << setprecision(6) << "  aluminium vs fresh rebuild: Rs. " << drift << " apart, windows "
+         << tree.project().windows << " / " << fresh.project().windows << "\n";
+}
 
-class FinalCostCalculator {
-public:
-    static void calculate(float aluminiumTotal, float totalSqFt, int windowCount) {
-        float glassRate, laborRate, hardwareRate, discountPercent;
+void ProjectImporter::benchmark(size_t rows) {
+    const string path = "survey_bench.csv";
+    OrderGenerator gen(19);
+    mt19937 rng(19);
+    {
+        ofstream out(path);
+        out << "type,qty,tag,units,collar,h,w,wr,tee,net,netwidth,hasnet,d46,coller,shape,arch,rise,segments\n";
+        // The same size written the ways surveyors do.
+        auto size = [&](float inches) -> string {
+            char cell[48];
+            switch (rng() % 4) {
+                case 0: snprintf(cell, sizeof cell, "%g", inches); break;
+                case 1: snprintf(cell, sizeof cell, "%gmm", round(inches * 254) / 10); break;
+                case 2: snprintf(cell, sizeof cell, "%g cm", round(inches * 254) / 100); break;
+                default: {
+                    int eighths = static_cast<int>(round(inches * 8));
+                    int feet = eighths / 96, whole = eighths % 96 / 8, part = eighths % 8;
+                    if (part) snprintf(cell, sizeof cell, "\"%d'%d %d/8\"\"\"", feet, whole, part);
+                    else snprintf(cell, sizeof cell, "\"%d'%d\"\"\"", feet, whole);
+                }
+            }
+            return cell;
+        };
+        for (size_t i = 0; i < rows; ++i) {
+            WindowSpec s = gen.next();
+            out << s.type << ",1," << gen.floorTag() << ",in," << s.collar << ','
+                << (s.height > 0 ? size(s.height) : "") << ',' << size(s.width) << ','
+                << (s.widthRight > 0 ? size(s.widthRight) : "") << ',' << (s.tee > 0 ? size(s.tee) : "") << ','
+                << s.netType << ',' << (s.netWidth > 0 ? size(s.netWidth) : "") << ','
+                << s.hasNet << ',' << s.includeD46 << ',' << s.hasColler << ',' << s.archShape << ','
+                << (s.arch > 0 ? size(s.arch) : "") << ',' << (s.rise > 0 ? size(s.rise) : "") << ','
+                << (s.segments.empty() ? "" : "\"" + s.segments + "\"") << "\n";
+        }
+    }
 
-        cout << "\nEnter glass rate (Rs./sqft): ";
-        cin >> glassRate;
-        cout << "Enter labor rate (Rs./sqft): ";
-        cin >> laborRate;
-        cout << "Enter hardware cost per window: ";
-        cin >> hardwareRate;
-        cout << "Enter discount (%): ";
-        cin >> discountPercent;
+    vector<Item> items;
+    vector<string> errors;
+    auto start = chrono::steady_clock::now();
+    readItems(path, items, errors);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    addMeasuredSeconds(seconds);
+    filesystem::remove(path);
+
+    cout << fixed << setprecision(3);
+    cout << "Survey of " << rows << " rows (in, mm, cm, ft-in): " << items.size() << " valid, " << errors.size()
+         << " rejected, read in " << seconds << " s (" << rows / max(seconds, 1e-9) / 1e3 << " k rows/s)\n";
+    for (size_t i = 0; i < errors.size() && i < 5; ++i) cout << "  " << errors[i] << "\n";
+}
 
-        float glass = glassRate * totalSqFt;
-        float labor = laborRate * totalSqFt;
-        float hardware = hardwareRate * windowCount;
+void HardwareKits::benchmark(size_t count) {
+    OrderGenerator gen(11);
+    vector<QuoteEntry> order(count);
+    for (auto& entry : order) {
+        WindowSpec spec = gen.next();
+        entry.window = createComponent(spec.type);
+        entry.window->loadSpec(spec);
+        entry.type = spec.type;
+    }
 
-        float discount = (discountPercent / 100.0f) * aluminiumTotal;
-        float discountedAluminium = aluminiumTotal - discount;
-        float net = discountedAluminium + glass + labor + hardware;
+    auto start = chrono::steady_clock::now();
+    PartTable totals = aggregate(order);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    addMeasuredSeconds(seconds);
+
+    size_t lines = 0;
+    vector<HardwareLine> kit;
+    for (const auto& entry : order) {
+        kit.clear();
+        entry.window->getHardware(kit);
+        lines += kit.size();
+    }
 
-        cout << "\n--- Final Summary ---\n";
-        cout << "Aluminium (before discount): Rs. " << aluminiumTotal << "\n";
-        cout << "Discount on Aluminium (" << discountPercent << "%): Rs. " << discount << "\n";
-        cout << "Aluminium (after discount): Rs. " << discountedAluminium << "\n";
-        cout << "Glass: Rs. " << glass << "\n";
-        cout << "Labor: Rs. " << labor << "\n";
-        cout << "Hardware: Rs. " << hardware << "\n";
-        cout << "Net Total: Rs. " << net << "\n";
+    cout << fixed << setprecision(2);
+    cout << "Aggregated " << lines << " part lines from " << count << " windows into " << totals.size()
+         << " parts in " << seconds << " s (" << lines / max(seconds, 1e-9) / 1e6 << " M lines/s)\n";
+}
 
+// Writes the itemised lines of N synthetic quotes to a file, once through
+// an ofstream with fixed/setprecision and once through Report, then again
+// with one Report per worker thread.
+void benchmarkReportOutput(size_t count, const string& path) {
+    OrderGenerator gen(17);
+    RateTable rates(SoakTest::syntheticRates(99));
+    vector<QuoteCache::Quote> quotes(count);
+    for (auto& q : quotes) {
+        WindowSpec spec = gen.next();
+        unique_ptr<FrameComponent> win = createComponent(spec.type);
+        win->loadSpec(spec);
+        q = QuoteCache::quote(*win, rates);
     }
-};
+    size_t lines = 0;
+    for (const auto& q : quotes) lines += q.lines.size();
 
-/////////////////////////////////////////////////////////
-// 🏗️ Factory Function to Add More Types Later Easily
-/////////////////////////////////////////////////////////
+    auto timed = [](auto&& body) {
+        auto start = chrono::steady_clock::now();
+        body();
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    };
 
-unique_ptr<FrameComponent> createComponent(int type) {
-    if (type == 1) return make_unique<FlexiblePanelWindow>(true, false);  // Three Panel
-    if (type == 2) return make_unique<FlexiblePanelWindow>(false, true);  // Two Panel
-    if (type == 3) return make_unique<ThreePanel_3glass>(true, "DC30", "DC26");  // with D29
-    if (type == 4) return make_unique<ThreePanel_3glass>(false, "M30", "M26");   // Without D29
-    if (type == 5) return make_unique<FixWindow>();                           // Fix window 
-    if (type == 6) return make_unique<RandomFixWindow>();                     // Random Fix
-    if (type == 7) return make_unique<OpenableWindow>();                      // Openable
-    if (type == 8) return make_unique<DoorWindow>(false);                     // Single Door
-    if (type == 9) return make_unique<DoorWindow>(true);                      // Double Door ✅
-    if (type == 10) return make_unique<QadialArchWindow>();                   // Qadial Arch
-    if (type == 11) return make_unique<RoundArchWindow>();                    // Curve Arch
-    if (type == 12) return make_unique<FixCornerWindow>();                    // Fix Corner
-    if (type == 13) return make_unique<SlideCornerWindow>(true, "DC30", "DC26");  // Corner Window
-    if (type == 14) return make_unique<SlideCornerWindow>(false, "M30", "M26");  // Corner M section
-                                                                                
-    return nullptr;
+    double streamSeconds = timed([&] {
+        ofstream file(path);
+        file << fixed << setprecision(2);
+        for (const auto& q : quotes)
+            for (const auto& item : q.lines)
+                file << item.section << ": " << item.inches << " inches = " << item.inches / 12.0f
+                     << " ft => rounded = " << item.roundedFeet << " => Rs. " << item.price << "\n";
+    });
+
+    auto renderTo = [&](size_t begin, size_t end, FILE* file) {
+        Report& out = Report::out();
+        out.redirect(file);
+        {
+            Report::Batch batch;
+            for (size_t i = begin; i < end; ++i) {
+                for (const auto& item : quotes[i].lines)
+                    FrameComponent::printSectionLine(item.section, item.inches, item.roundedFeet, item.price);
+                out.done();
+            }
+        }
+        out.redirect(stdout);
+    };
+
+    double reportSeconds = timed([&] {
+        FILE* file = fopen(path.c_str(), "w");
+        if (!file) return;
+        renderTo(0, count, file);
+        fclose(file);
+    });
+
+    unsigned threads = max(1u, thread::hardware_concurrency());
+    double parallelSeconds = timed([&] {
+        FILE* file = fopen(path.c_str(), "w");
+        if (!file) return;
+        parallelFor(count, threads, [&](size_t begin, size_t end, unsigned) { renderTo(begin, end, file); });
+        fclose(file);
+    });
+    addMeasuredSeconds(streamSeconds + reportSeconds + parallelSeconds);
+
+    cout << fixed << setprecision(3);
+    cout << "Itemised " << lines << " lines from " << count << " quotes to " << path << "\n";
+    cout << "  ofstream + setprecision: " << streamSeconds << " s\n";
+    cout << "  Report (to_chars):       " << reportSeconds << " s (" << streamSeconds / max(reportSeconds, 1e-9)
+         << "x)\n";
+    cout << "  Report, " << threads << " thread(s):  " << parallelSeconds << " s\n";
 }
 
 /////////////////////////////////////////////////////////
 // 🧵 Main Application Logic
 /////////////////////////////////////////////////////////
 
-int main() {
-    vector<unique_ptr<FrameComponent>> windows;
+// The whole program, behind main() so the CMake build can link it as a
+// library (WF_LIBRARY) into the CLI and the benchmark driver.
+int runWindowFabricator(int argc, char* argv[]) {
+    // Plug-in window types are registered by now; worker threads read it lock-free.
+    ComponentRegistry::freeze();
+
+    // A journaled or replayed session runs the menu below as usual.
+    SessionJournal& journal = SessionJournal::get();
+    if (argc >= 3 && string(argv[1]) == "--record") {
+        if (!journal.startRecording(argv[2])) return 1;
+    } else if (argc >= 3 && string(argv[1]) == "--replay") {
+        if (!journal.startReplay(argv[2], argc >= 4 ? argv[3] : "")) return 1;
+
+    // Batch tools, no prompts
+    } else if (argc >= 2) {
+        string mode = argv[1];
+        if (mode == "--list-types") {
+            ComponentRegistry::printTable();
+            return 0;
+        }
+        if (mode == "--golden-write" && argc >= 3) return SectionRegression::writeGolden(argv[2]) ? 0 : 1;
+        if (mode == "--golden-check" && argc >= 3) return SectionRegression::checkGolden(argv[2]) ? 0 : 1;
+        if (mode == "--schedule-bench") {
+            ShopScheduler::benchmark(argc >= 3 ? atoi(argv[2]) : 10000);
+            return 0;
+        }
+        if (mode == "--bench-memory") {
+            PackedWindowStore::benchmark(argc >= 3 ? strtoull(argv[2], nullptr, 10) : 10000000);
+            return 0;
+        }
+        if (mode == "--soak") {
+            size_t count = argc >= 3 ? strtoull(argv[2], nullptr, 10) : 1000000;
+            int rounds = argc >= 4 ? atoi(argv[3]) : 5;
+            return SoakTest::run(count, max(1, rounds)) ? 0 : 1;
+        }
+        if (mode == "--bench-scenarios") {
+            RateScenarios::benchmark(argc >= 3 ? strtoull(argv[2], nullptr, 10) : 200000);
+            return 0;
+        }
+        if (mode == "--bench-hardware") {
+            HardwareKits::benchmark(argc >= 3 ? strtoull(argv[2], nullptr, 10) : 1000000);
+            return 0;
+        }
+        if (mode == "--bench-cutlist") {
+            CutList::benchmark(argc >= 3 ? strtoull(argv[2], nullptr, 10) : 100000);
+            return 0;
+        }
+        if (mode == "--bench-output") {
+            benchmarkReportOutput(argc >= 3 ? strtoull(argv[2], nullptr, 10) : 200000,
+                                  argc >= 4 ? argv[3] : "bench_output.txt");
+            return 0;
+        }
+        if (mode == "--bench-survey") {
+            ProjectImporter::benchmark(argc >= 3 ? strtoull(argv[2], nullptr, 10) : 100000);
+            return 0;
+        }
+        if (mode == "--bench-tree") {
+            ProjectTree::benchmark(argc >= 3 ? strtoull(argv[2], nullptr, 10) : 100000);
+            return 0;
+        }
+        if (mode == "--fuzz") {
+            long long cases = argc >= 3 ? atoll(argv[2]) : 1000000;
+            unsigned threads = max(1u, thread::hardware_concurrency());
+            return SectionRegression::fuzz(cases, threads) ? 0 : 1;
+        }
+
+        cerr << "Usage: " << argv[0] << " [option]\n"
+             << "  --list-types              show registered window types and their project file keys\n"
+             << "  --golden-write FILE       capture section formulas for every type/collar/option\n"
+             << "  --golden-check FILE       compare current formulas against a captured corpus\n"
+             << "  --fuzz [CASES]            compare registered fast paths on random windows\n"
+             << "  --record FILE             run the menu as usual, journaling input, rates and results\n"
+             << "  --replay FILE [RATES.csv] re-run a journal with no prompts and diff the results;\n"
+             << "                            RATES.csv (section,rate) replaces recorded rates\n"
+             << "  --schedule-bench [N]      schedule N random windows on the shop floor\n"
+             << "  --bench-memory [N]        pack N random windows and report memory\n"
+             << "  --bench-scenarios [N]     price N windows under 1 and 16 rate scenarios\n"
+             << "  --bench-hardware [N]      expand and aggregate hardware kits for N windows\n"
+             << "  --bench-cutlist [N]       build the sorted cut list for N windows\n"
+             << "  --bench-output [N] [FILE] write N itemised quotes through ofstream and Report\n"
+             << "  --bench-survey [N]        read an N-row mixed-unit survey CSV\n"
+             << "  --bench-tree [N]          build, edit and query a site/floor/room tree of N windows\n"
+             << "  --soak [N] [ROUNDS]       price and summarise N-window synthetic orders repeatedly\n";
+        return 1;
+    }
+
+    PackedWindowStore packedWindows;  // imported windows; outlives the entries that point into it
+    vector<QuoteEntry> windows;
     float totalAluminium = 0, totalSqFt = 0;
+    OffcutInventory offcuts;
+    PriceBook priceBook;
+    QuoteCache quoteCache;
+    ProjectTree tree;
+    if (size_t lists = priceBook.loadFolder())
+        cout << "🏷️ Loaded " << lists << " price list(s): " << priceBook.sectionCount() << " sections from "
+             << priceBook.supplierCount() << " supplier(s).\n";
 
     while (true) {
+        journal.checkpoint(totalAluminium, totalSqFt, windows.size());
+
         int choice;
         cout << "\n=== Main Menu ===\n";
         cout << "1. Estimate Price\n";
-        cout << "2. Length Derivation (Coming Soon)\n";
+        cout << "2. Cut List (Length Derivation)\n";
         cout << "3. Final Summary\n";
+        cout << "4. Offcut Inventory\n";
+        cout << "5. Fabrication Schedule\n";
+        cout << "6. Supplier Price Lists\n";
+        cout << "7. Import Project File (mixed window types)\n";
+        cout << "8. Cost Sensitivity Analysis\n";
+        cout << "9. Rate Scenario Band (rate_scenarios.csv)\n";
+        cout << "10. Net Mesh Cutting Plan\n";
+        cout << "11. Hardware Kits\n";
+        cout << "12. Project Tree (site/floor/room subtotals)\n";
         cout << "0. Exit\n";
         cout << "Select Option: ";
         if (!(cin >> choice)) {
+            if (cin.eof()) break;
             cout << "Invalid input. Please enter a number.\n";
             cin.clear(); cin.ignore(10000, '\n'); continue;
         }
@@ -1225,22 +7208,7 @@ int main() {
 
         } else if (choice == 1) {
             cout << "\n--- Window Types ---\n";
-            cout << "1. Three Panel Window\n";
-            cout << "2. Two Panel Window (M section)\n";
-            cout << "3. Three Panel Window (3 glass part)\n";
-            cout << "4. Two Panel Window (3 glass part & M section)\n";
-            cout << "5. Fixed Window\n";
-            cout << "6. Random Design Fixed Window\n";
-            cout << "7. openable Window\n";
-            cout << "8. Single Door\n";
-            cout << "9. Double Door\n";
-            cout << "10. Qadial Top Arch\n";
-            cout << "11. Round Top Arch\n";
-            cout << "12. Fix corner Window\n";
-            cout << "13. Slide Corner Window\n";
-            cout << "14. Slide Corner Window (M section)\n";
-
-            // ✅ Add future window types here
+            ComponentRegistry::printMenu();
 
             int winType, qty;
             cout << "Enter window type number: ";
@@ -1258,53 +7226,358 @@ int main() {
                 cout << "Invalid quantity.\n"; cin.clear(); cin.ignore(10000, '\n'); continue;
             }
 
-            map<string, float> rates;
-            set<string> neededSections;
+            string tag;
+            cout << "Enter location for this batch (e.g. GF, TowerA/F1/Kitchen, - for none): ";
+            cin >> tag;
+
             vector<unique_ptr<FrameComponent>> batch;
+            AsyncBatchPricer pricer(priceBook);
+            long long computedBefore = FrameComponent::sectionComputationCount();
+            InchesField::Limits sizeLimits(ComponentRegistry::find(winType));
 
             for (int i = 0; i < qty; ++i) {
                 cout << "\n--- Enter details for Window " << (i + 1) << " ---\n";
                 auto win = createComponent(winType);
                 win->inputDimensions();
-                auto sec = win->getRequiredSections();
-                for (auto& s : sec) neededSections.insert(s.first);
                 totalSqFt += win->getArea();
+                pricer.submit(win.get());
                 batch.push_back(move(win));
+                pricer.printProgress();
             }
 
-            for (const auto& secName : neededSections) {
-                cout << "Enter rate for " << secName << " (Rs./ft): ";
-                float rate;
-                while (!(cin >> rate) || rate < 0) {
-                    cout << "Invalid rate. Enter again: ";
-                    cin.clear(); cin.ignore(10000, '\n');
+            set<string> neededSections = pricer.finish();
+            RateTable rates(collectRates(neededSections, priceBook));
+
+            // Windows the background worker priced are only printed; of the
+            // rest, standard catalog windows come straight from the cache.
+            {
+                Report::Batch itemised;  // whole batch written in large blocks
+                for (size_t i = 0; i < batch.size(); ++i) {
+                    auto& win = batch[i];
+                    win->displayType();
+
+                    WindowSpec spec = win->getSpec();
+                    spec.type = winType;
+                    string key = QuoteCache::keyText(spec, *win, rates);
+
+                    QuoteCache::Quote q;
+                    bool fromWorker = pricer.result(i, rates, q);
+                    if (fromWorker || quoteCache.get(key, q)) {
+                        for (const auto& item : q.lines)
+                            FrameComponent::printSectionLine(item.section, item.inches, item.roundedFeet,
+                                                             item.price, !fromWorker);
+                        Report::out().done();
+                        totalAluminium += q.total;
+                        if (fromWorker) quoteCache.put(key, move(q));
+                        continue;
+                    }
+
+                    float price = win->calculateTotalPrice(rates.byName());
+                    totalAluminium += price;
+                    quoteCache.put(key, QuoteCache::quote(*win, rates));
                 }
-                rates[secName] = rate;
+            }
+            quoteCache.save();
+            quoteCache.printStats();
+            cout << "Section maps computed for this batch: "
+                 << FrameComponent::sectionComputationCount() - computedBefore << " for " << qty << " window(s)\n";
+
+            if (!offcuts.empty()) {
+                char useOffcuts;
+                cout << "\nUse offcuts from inventory for this batch? (y/n): ";
+                cin >> useOffcuts;
+                if (useOffcuts == 'y' || useOffcuts == 'Y')
+                    totalAluminium -= offcuts.applyToBatch(batch, rates.byName());
             }
 
+            auto batchRates = make_shared<const RateTable>(move(rates));
             for (auto& win : batch) {
-                win->displayType();
-                float price = win->calculateTotalPrice(rates);
-                totalAluminium += price;
-                windows.push_back(move(win));
+                QuoteEntry entry;
+                entry.window = move(win);
+                entry.type = winType;
+                entry.tag = tag;
+                entry.rates = batchRates;
+                entry.treeId = tree.insert(entry);
+                windows.push_back(move(entry));
             }
 
             cout << "\n✅ Added " << qty << " window(s) successfully.\n";
 
         } else if (choice == 2) {
-            cout << "🚧 Length Derivation Feature Coming Soon!\n";
+            if (windows.empty()) {
+                cout << "⚠️ No windows added yet.\n";
+                continue;
+            }
+
+            char useOffcuts, exportChoice;
+            cout << "Mark pieces that stored offcuts can cover? (y/n): ";
+            cin >> useOffcuts;
+
+            // A copy: the preview must not use up the stored racks.
+            OffcutInventory rack = offcuts;
+            bool withOffcuts = (useOffcuts == 'y' || useOffcuts == 'Y') && !rack.empty();
+            auto groups = CutList::build(windows, withOffcuts ? &rack : nullptr);
+            CutList::print(groups);
+
+            cout << "\nExport full cut list to cutlist.csv? (y/n): ";
+            cin >> exportChoice;
+            if ((exportChoice == 'y' || exportChoice == 'Y') && CutList::exportCsv(groups, "cutlist.csv"))
+                cout << "✅ Cut list written to cutlist.csv\n";
 
         } else if (choice == 3) {
             if (windows.empty()) {
                 cout << "⚠️ No windows added yet to calculate summary.\n";
             } else {
-                FinalCostCalculator::calculate(totalAluminium, totalSqFt, windows.size());
+                vector<CostRates> rateSets = FinalCostCalculator::loadRates();
+                if (rateSets.empty()) rateSets.push_back(FinalCostCalculator::promptRates());
+
+                // One pass over the stored windows, then every rate set is
+                // applied to the same accumulated buckets.
+                long long computedBefore = FrameComponent::sectionComputationCount();
+                HardwareKits kits;
+                bool priceKits = kits.loadPrices();
+                ProjectSummary summary;
+                for (const auto& entry : windows) summary.add(entry, priceKits ? &kits : nullptr);
+
+                for (const auto& r : rateSets) {
+                    FinalCostCalculator::calculate(totalAluminium, totalSqFt, windows.size(), r,
+                                                   summary.kitHardware());
+                    summary.report(r);
+                }
+                cout << "\nSection maps computed for this summary: "
+                     << FrameComponent::sectionComputationCount() - computedBefore << " for "
+                     << windows.size() << " window(s)\n";
+                if (fabs(summary.aluminium() - totalAluminium) > 0.01f)
+                    cout << "\nℹ️ Breakdown aluminium is before offcut savings (Rs. "
+                         << summary.aluminium() - totalAluminium << ").\n";
+            }
+        } else if (choice == 5) {
+            if (windows.empty()) {
+                cout << "⚠️ No windows added yet to schedule.\n";
+                continue;
+            }
+
+            vector<unique_ptr<FrameComponent>> unpacked;  // packed windows, for the length of the schedule
+            vector<const FrameComponent*> order;
+            for (const auto& entry : windows) {
+                if (!entry.window) unpacked.push_back(entry.packedIn->materialize(entry.packedAt));
+                order.push_back(entry.window ? entry.window.get() : unpacked.back().get());
+            }
+
+            ShopScheduler scheduler;
+            scheduler.schedule(order);
+            scheduler.printSummary();
+            scheduler.printGantt();
+
+            char exportChoice;
+            cout << "\nExport full schedule to schedule.csv? (y/n): ";
+            cin >> exportChoice;
+            if ((exportChoice == 'y' || exportChoice == 'Y') && scheduler.exportCsv("schedule.csv"))
+                cout << "✅ Schedule written to schedule.csv\n";
+
+        } else if (choice == 7) {
+            string path;
+            cout << "Enter project file or survey CSV path: ";
+            cin >> path;
+            size_t before = windows.size();
+            if (ProjectImporter::importFile(path, priceBook, quoteCache, packedWindows, windows, totalAluminium, totalSqFt))
+                cout << "\n✅ Project imported successfully.\n";
+            for (size_t i = before; i < windows.size(); ++i) windows[i].treeId = tree.insert(windows[i]);
+
+        } else if (choice == 8) {
+            if (windows.empty()) {
+                cout << "⚠️ No windows added yet to analyse.\n";
+                continue;
+            }
+
+            vector<CostRates> rateSets = FinalCostCalculator::loadRates();
+            if (rateSets.empty()) rateSets.push_back(FinalCostCalculator::promptRates());
+
+            int topN;
+            cout << "How many top contributors to list? ";
+            if (!(cin >> topN) || topN <= 0) {
+                cout << "Invalid input.\n"; cin.clear(); cin.ignore(10000, '\n'); continue;
+            }
+
+            HardwareKits kits;
+            bool priceKits = kits.loadPrices();
+            CostSensitivity analysis;
+            analysis.build(windows, priceKits ? &kits : nullptr);
+            for (const auto& r : rateSets) analysis.report(r, topN);
+
+        } else if (choice == 9) {
+            if (windows.empty()) {
+                cout << "⚠️ No windows added yet to price.\n";
+                continue;
+            }
+
+            RateScenarios scenarios;
+            if (!scenarios.load()) {
+                cout << "⚠️ rate_scenarios.csv not found. Format:\n"
+                     << "    section,low,expected,high\n"
+                     << "    D41,70,80,95\n";
+                continue;
+            }
+            scenarios.report(windows);
+
+        } else if (choice == 10) {
+            if (windows.empty()) {
+                cout << "⚠️ No windows added yet.\n";
+                continue;
+            }
+            NetNester::report(windows, ShopConfig::load());
+
+        } else if (choice == 11) {
+            if (windows.empty()) {
+                cout << "⚠️ No windows added yet.\n";
+                continue;
+            }
+            HardwareKits kits;
+            if (!kits.loadPrices())
+                cout << "ℹ️ hardware_prices.csv not found (part,price); showing quantities only.\n";
+            kits.report(windows);
+
+        } else if (choice == 12) {
+            if (windows.empty()) {
+                cout << "⚠️ No windows added yet.\n";
+                continue;
+            }
+            vector<CostRates> rateSets = FinalCostCalculator::loadRates();
+            if (rateSets.empty()) rateSets.push_back(FinalCostCalculator::promptRates());
+            for (const auto& r : rateSets) tree.report(r);
+
+            int action;
+            cout << "\n1. Subtotal and profile lengths for a location\n";
+            cout << "2. Move a window to another location\n";
+            cout << "3. Re-enter a window's dimensions\n";
+            cout << "4. Remove a window\n";
+            cout << "0. Back\n";
+            cout << "Select Option: ";
+            if (!(cin >> action)) {
+                cout << "Invalid input.\n"; cin.clear(); cin.ignore(10000, '\n'); continue;
+            }
+
+            if (action == 1) {
+                string path;
+                cout << "Enter location (e.g. TowerA/F1, - for the whole project): ";
+                cin >> path;
+                tree.printBom(path);
+                continue;
+            }
+            if (action < 2 || action > 4) continue;
+
+            size_t number;
+            cout << "Enter window number (1 to " << windows.size() << "): ";
+            if (!(cin >> number) || number < 1 || number > windows.size()) {
+                cout << "Invalid window number.\n"; cin.clear(); cin.ignore(10000, '\n'); continue;
+            }
+            QuoteEntry& entry = windows[number - 1];
+            unique_ptr<FrameComponent> scratch;
+            float oldAluminium = entry.view(scratch).aluminiumCost(*entry.rates), newAluminium = 0;
+
+            if (action == 2) {
+                cout << "Enter new location: ";
+                cin >> entry.tag;
+                tree.update(entry.treeId, entry);
+                cout << "✅ Window #" << number << " moved to " << entry.tag << ".\n";
+            } else if (action == 3) {
+                cout << "\n--- " << windowTypeName(entry.type) << " ---\n";
+                FrameComponent& win = entry.own();
+                totalSqFt -= win.getArea();
+                InchesField::Limits sizeLimits(ComponentRegistry::find(entry.type));
+                win.inputDimensions();
+                totalSqFt += win.getArea();
+                newAluminium = win.aluminiumCost(*entry.rates);
+                totalAluminium += newAluminium - oldAluminium;
+                tree.update(entry.treeId, entry);
+                cout << fixed << setprecision(2) << "✅ Window #" << number << " re-priced: Rs. " << oldAluminium
+                     << " => Rs. " << newAluminium << " (batch rates; sections without a rate count as 0).\n";
+            } else {
+                tree.remove(entry.treeId);
+                totalAluminium -= oldAluminium;
+                totalSqFt -= entry.view(scratch).getArea();
+                windows.erase(windows.begin() + (number - 1));
+                cout << "✅ Window #" << number << " removed; later windows move up one number.\n";
+            }
+
+        } else if (choice == 6) {
+            int action;
+            priceBook.display();
+            cout << "\n1. Use cheapest supplier\n";
+            cout << "2. Use preferred supplier\n";
+            cout << "3. Reload price lists\n";
+            cout << "0. Back\n";
+            cout << "Select Option: ";
+            if (!(cin >> action)) {
+                cout << "Invalid input.\n"; cin.clear(); cin.ignore(10000, '\n'); continue;
+            }
+
+            if (action == 1) {
+                priceBook.useCheapest();
+            } else if (action == 2) {
+                string supplier;
+                cout << "Enter supplier name: ";
+                cin >> supplier;
+                if (!priceBook.usePreferred(supplier)) cout << "⚠️ Unknown supplier: " << supplier << "\n";
+            } else if (action == 3) {
+                cout << "🏷️ Loaded " << priceBook.reload() << " price list(s).\n";
+            }
+
+        } else if (choice == 4) {
+            int action;
+            cout << "\n--- Offcut Inventory (" << offcuts.count() << " pieces) ---\n";
+            cout << "1. Show inventory\n";
+            cout << "2. Add offcut\n";
+            cout << "3. Remove offcut\n";
+            cout << "Select Option: ";
+            if (!(cin >> action)) {
+                cout << "Invalid input.\n"; cin.clear(); cin.ignore(10000, '\n'); continue;
+            }
+
+            if (action == 1) {
+                offcuts.display();
+            } else if (action == 2 || action == 3) {
+                string code;
+                float inches;
+                cout << "Enter section code (e.g. D54F): ";
+                cin >> code;
+                cout << "Enter offcut length " << kSizeUnits << ": ";
+                while (!(cin >> asInches(inches)) || inches <= 0) {
+                    cout << "Invalid length. Enter again: ";
+                    cin.clear(); cin.ignore(10000, '\n');
+                }
+
+                if (action == 2) {
+                    if (inches < OffcutInventory::kMinUsableLength) {
+                        cout << "⚠️ Offcuts shorter than " << OffcutInventory::kMinUsableLength
+                             << " inches are treated as scrap.\n";
+                        continue;
+                    }
+                    offcuts.add(code, inches);
+                } else if (!offcuts.remove(code, inches)) {
+                    cout << "⚠️ No " << code << " offcut of that length in inventory.\n";
+                    continue;
+                }
+                offcuts.save();
+                cout << "✅ Inventory updated.\n";
+            } else {
+                cout << "❌ Invalid option.\n";
             }
         } else {
             cout << "❌ Invalid option. Try again.\n";
         }
     }
 
+    journal.checkpoint(totalAluminium, totalSqFt, windows.size());
+    if (journal.replaying()) journal.finishReplay(false);
+    journal.close();
+
     cout << "\n✅ Program Ended Successfully.\n";
     return 0;
 }
+
+#ifndef WF_LIBRARY
+int main(int argc, char* argv[]) {
+    return runWindowFabricator(argc, argv);
+}
+#endif
@@ -0,0 +1,121 @@
+// Benchmark suite for the CMake build: runs the program's built-in
+// benchmarks on fixed-seed synthetic workloads and reports throughput.
+// Only the section each benchmark measures is timed (the figure it
+// prints), not building its workload, its checks or its report.
+// The same run is the training workload for the PGO build, and
+// scripts/compare_variants.sh compares its numbers across build variants.
+//
+//     wf_bench [--quick] [--repeat K] [--csv] [workload...]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
+using namespace std;
+
+int runWindowFabricator(int argc, char* argv[]);
+double takeMeasuredSeconds();
+
+struct Workload {
+    const char* name;
+    const char* mode;    // the program's benchmark option
+    size_t items;        // at full size
+    const char* extra;   // further argument, "@name" for a temporary file, or nullptr
+    const char* unit;
+};
+
+// Seeds are fixed inside each benchmark, so every build sees the same work.
+static const Workload kWorkloads[] = {
+    { "pricing",   "--soak",            200000, "3",                 "windows" },  // 3 rounds
+    { "scenarios", "--bench-scenarios", 100000, nullptr,             "windows" },
+    { "hardware",  "--bench-hardware",  500000, nullptr,             "windows" },
+    { "cutlist",   "--bench-cutlist",   100000, nullptr,             "windows" },
+    { "survey",    "--bench-survey",     50000, nullptr,             "rows" },
+    { "tree",      "--bench-tree",       50000, nullptr,             "windows" },
+    { "output",    "--bench-output",    100000, "@output",           "quotes" },  // a temporary file
+    { "fuzz",      "--fuzz",            200000, nullptr,             "cases" },
+};
+
+// Swallows the benchmarks' own reports.
+struct NullBuf : streambuf {
+    int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+    streamsize xsputn(const char*, streamsize n) override { return n; }
+};
+
+static bool runOnce(const Workload& w, size_t items, double& seconds) {
+    string count = to_string(items);
+    vector<string> args = { "wf_bench", w.mode, count };
+    filesystem::path scratch;
+    if (w.extra && w.extra[0] == '@') {
+        scratch = filesystem::temp_directory_path() / ("wf_bench_" + string(w.extra + 1) + ".txt");
+        args.push_back(scratch.string());
+    } else if (w.extra) {
+        args.push_back(w.extra);
+    }
+    vector<char*> argv;
+    for (string& a : args) argv.push_back(&a[0]);
+    argv.push_back(nullptr);
+
+    NullBuf null;
+    streambuf* saved = cout.rdbuf(&null);
+    takeMeasuredSeconds();
+    int rc = runWindowFabricator(static_cast<int>(args.size()), argv.data());
+    seconds = takeMeasuredSeconds();
+    cout.rdbuf(saved);
+
+    error_code ignored;
+    if (!scratch.empty()) filesystem::remove(scratch, ignored);
+    return rc == 0 && seconds > 0;
+}
+
+int main(int argc, char* argv[]) {
+    bool quick = false, csv = false;
+    int repeat = 3;
+    vector<string> only;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--quick")) quick = true;
+        else if (!strcmp(argv[i], "--csv")) csv = true;
+        else if (!strcmp(argv[i], "--repeat") && i + 1 < argc) repeat = max(1, atoi(argv[++i]));
+        else if (argv[i][0] == '-') {
+            cerr << "Usage: " << argv[0] << " [--quick] [--repeat K] [--csv] [workload...]\n  workloads:";
+            for (const Workload& w : kWorkloads) cerr << ' ' << w.name;
+            cerr << "\n";
+            return 1;
+        } else only.push_back(argv[i]);
+    }
+
+    if (csv) cout << "workload,items,best_seconds,items_per_second\n";
+    else cout << left << setw(11) << "Workload" << right << setw(10) << "Items" << setw(11) << "Best s"
+              << setw(14) << "Items/s" << "  (best of " << repeat << ")\n";
+
+    bool ok = true;
+    for (const Workload& w : kWorkloads) {
+        if (!only.empty() && find(only.begin(), only.end(), w.name) == only.end()) continue;
+        size_t items = quick ? max<size_t>(w.items / 10, 1) : w.items;
+        size_t counted = w.extra && !strcmp(w.mode, "--soak") ? items * atoi(w.extra) : items;
+
+        double best = 0;
+        for (int r = 0; r < repeat; ++r) {
+            double seconds;
+            if (!runOnce(w, items, seconds)) {
+                cerr << "❌ " << w.name << " failed\n";
+                ok = false;
+                break;
+            }
+            if (r == 0 || seconds < best) best = seconds;
+        }
+        double rate = counted / max(best, 1e-9);
+
+        if (csv) cout << w.name << ',' << counted << ',' << fixed << setprecision(4) << best << ','
+                      << setprecision(0) << rate << "\n";
+        else cout << left << setw(11) << w.name << right << setw(10) << counted << fixed << setprecision(3)
+                  << setw(11) << best << setprecision(0) << setw(14) << rate << ' ' << w.unit << "/s\n";
+        cout.flush();
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,8 @@
+// Command-line entry point for the CMake build; the program itself lives in
+// 13EX.cpp (built as the wf_core library).
+
+int runWindowFabricator(int argc, char* argv[]);
+
+int main(int argc, char* argv[]) {
+    return runWindowFabricator(argc, argv);
+}
@@ -0,0 +1,104 @@
+#!/usr/bin/env bash
+# Builds each CMake preset, runs the same wf_bench workloads on each and
+# prints throughput relative to the plain release build.
+#
+#     scripts/compare_variants.sh [--quick] [--rounds K] [preset...]
+#
+# Default presets: release lto native pgo pgo-lto. The PGO presets train
+# first: the pgo-train build runs wf_bench once and leaves its profile in
+# _build/pgo-profile. All variants are built before anything is timed, then
+# each round runs every variant once in turn, so drift in machine load hits
+# them alike; each workload keeps its best round. The workloads are
+# fixed-seed. Raw numbers go to _build/compare/<preset>.csv.
+set -euo pipefail
+
+cd "$(dirname "$0")/.."
+root=$PWD
+out=$root/_build/compare
+profile=$root/_build/pgo-profile
+jobs=$(nproc 2>/dev/null || echo 2)
+
+bench_args=(--csv --repeat 1)
+rounds=3
+presets=()
+while [ $# -gt 0 ]; do
+    case $1 in
+        --quick) bench_args+=(--quick) ;;
+        --rounds) rounds=$2; shift ;;
+        -*) echo "usage: $0 [--quick] [--rounds K] [preset...]" >&2; exit 1 ;;
+        *) presets+=("$1") ;;
+    esac
+    shift
+done
+[ ${#presets[@]} -gt 0 ] || presets=(release lto native pgo pgo-lto)
+others=()
+for p in "${presets[@]}"; do [ "$p" = release ] || others+=("$p"); done
+presets=(release ${others[@]+"${others[@]}"})  # the baseline comes first
+
+build() {
+    cmake --preset "$1" >/dev/null
+    cmake --build --preset "$1" -j"$jobs" ${2:+--clean-first} >/dev/null
+}
+
+trained=0
+for p in "${presets[@]}"; do
+    case $p in
+        pgo*)
+            if [ $trained = 0 ]; then
+                echo "== pgo-train: instrumented build and training run"
+                rm -rf "$profile"
+                build pgo-train clean
+                (cd "$root/_build/pgo-train" && ./wf_bench --quick --repeat 1 >/dev/null)
+                if ls "$profile"/*.profraw >/dev/null 2>&1; then  # clang
+                    llvm-profdata merge -output="$profile/default.profdata" "$profile"/*.profraw
+                fi
+                trained=1
+            fi
+            echo "== build $p"
+            build "$p" clean  # objects built against an older profile would be reused otherwise
+            ;;
+        *)
+            echo "== build $p"
+            build "$p"
+            ;;
+    esac
+done
+
+mkdir -p "$out"
+for p in "${presets[@]}"; do : > "$out/$p.csv"; done
+for ((r = 1; r <= rounds; r++)); do
+    echo "== round $r of $rounds"
+    for p in "${presets[@]}"; do
+        (cd "$root/_build/$p" && ./wf_bench "${bench_args[@]}") >> "$out/$p.csv"
+    done
+done
+
+echo
+echo "Throughput relative to release (best of $rounds rounds; higher is better)"
+awk -F, -v order="${presets[*]}" '
+    $1 == "workload" { next }
+    {
+        preset = FILENAME; sub(/.*\//, "", preset); sub(/\.csv$/, "", preset)
+        if ($4 > rate[preset, $1]) rate[preset, $1] = $4
+        if (!($1 in seen)) { seen[$1] = 1; names[++n] = $1 }
+    }
+    END {
+        np = split(order, p, " ")
+        printf "%-11s", "workload"
+        for (j = 1; j <= np; j++) printf "%16s", p[j]
+        printf "\n"
+        for (i = 1; i <= n; i++) {
+            printf "%-11s", names[i]
+            base = rate["release", names[i]]
+            printf "%14.0f/s", base
+            for (j = 2; j <= np; j++) {
+                r = rate[p[j], names[i]]
+                printf "%15.3fx", (base > 0 ? r / base : 0)
+                if (base > 0 && r > 0) { logsum[j] += log(r / base); count[j]++ }
+            }
+            printf "\n"
+        }
+        printf "%-11s%16s", "geo. mean", ""
+        for (j = 2; j <= np; j++) printf "%15.3fx", (count[j] ? exp(logsum[j] / count[j]) : 0)
+        printf "\n"
+    }' $(for p in "${presets[@]}"; do echo "$out/$p.csv"; done)